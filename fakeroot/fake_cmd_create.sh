@@ -12,8 +12,8 @@ create()
     local kernel="$6"
     local initrd="$7"
     if [[ "${cachedev}" != "/dev/sda4" ]] \
-      || [[ "${imagefile}" != "ubuntu.cloop" ]] \
-      || [[ "${baseimagefile}" != "ubuntu.cloop" ]] \
+      || [[ "${imagefile}" != "ubuntu.qcow2" ]] \
+      || [[ "${baseimagefile}" != "ubuntu.qcow2" ]] \
       || [[ "${bootdev}" != "/dev/sda1" ]] \
       || [[ "${rootdev}" != "/dev/sda1" ]] \
       || [[ "${kernel}" != "/boot/vmlinuz" ]] \
@@ -12,7 +12,7 @@ upload()
       || [[ "${luser}" != "linbo" ]] \
       || [[ "${lpassword}" != "Muster!" ]] \
       || [[ "${cachedev}" != "/dev/sda4" ]] \
-      || [[ "${imagefile}" != "ubuntu.cloop" ]]; then
+      || [[ "${imagefile}" != "ubuntu.qcow2" ]]; then
         echo "Wrong parameters: «$*»"
         return 1
     fi
@@ -0,0 +1,64 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOACTIVITYMONITOR_H
+#define LINBOACTIVITYMONITOR_H
+
+#include <QObject>
+#include <QCoreApplication>
+#include <QAbstractEventDispatcher>
+#include <QElapsedTimer>
+#include <QEvent>
+
+/**
+ * @brief The LinboActivityMonitor class counts paint events and event loop wakeups.
+ *
+ * It is only meant for instrumentation: an idle LINBO screen should neither paint nor wake up, which
+ * can be checked by comparing two samples (eg. via the "activity" command of the control socket or in
+ * tests/tst_linboidle.cpp). Counting itself does not cause any wakeups, but every event of the application
+ * passes its event filter, so it only exists while somebody can ask for it.
+ */
+class LinboActivityMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LinboActivityMonitor(QObject* parent = nullptr);
+
+    typedef struct {
+        qint64 milliseconds;
+        qint64 paintEvents;
+        qint64 wakeups;
+    } Sample;
+
+    Sample sample();
+
+    static double paintEventsPerSecond(const Sample& from, const Sample& to);
+    static double wakeupsPerSecond(const Sample& from, const Sample& to);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    QElapsedTimer _elapsedTimer;
+    qint64 _paintEvents;
+    qint64 _wakeups;
+
+    static double _perSecond(qint64 count, qint64 milliseconds);
+};
+
+#endif // LINBOACTIVITYMONITOR_H
@@ -0,0 +1,92 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOAUTOSTARTPREPARATION_H
+#define LINBOAUTOSTARTPREPARATION_H
+
+#include <QThread>
+#include <QFile>
+#include <QStringList>
+#include <QCryptographicHash>
+#include <atomic>
+
+class LinboBackend;
+
+/**
+ * @brief The LinboAutostartPreparation class uses the autostart countdown for cheap preparations.
+ *
+ * It mounts the cache, reads the first megabyte of the partitions of the os (which contains
+ * the file system metadata) and, when the os is going to be synced, verifies the cached image
+ * against its .md5. Everything it reads ends up in the page cache, so linbo_cmd finds the cache
+ * mounted and the data warm when the countdown ends.
+ *
+ * The preparation runs in its own thread and can be aborted at any time without waiting for it.
+ * It then stops within one read of 4 MiB (or once a running mount returned) and releases the cache
+ * when it has finished, so linbo_cmd must only be started after the finished() signal.
+ */
+class LinboAutostartPreparation : public QThread
+{
+    Q_OBJECT
+public:
+    friend class LinboBackend;
+
+    ~LinboAutostartPreparation();
+
+    enum ImageCheck {
+        ImageNotChecked,
+        ImageOk,
+        ImageCorrupt,
+        ImageWithoutChecksum
+    };
+
+    bool cacheMounted() {
+        return this->_cacheMounted;
+    }
+    ImageCheck imageCheck() {
+        return this->_imageCheck;
+    }
+
+protected:
+    void run() override;
+
+private:
+    explicit LinboAutostartPreparation(QObject* parent = nullptr);
+
+    QString _cachePath;
+    QString _imageName;
+    QStringList _partitions;
+    QString _mountPoint;
+    bool _releaseRequested;
+    bool _keepCacheMounted;
+
+    std::atomic<bool> _abortRequested;
+    std::atomic<bool> _cacheMounted;
+    std::atomic<ImageCheck> _imageCheck;
+
+    static const int _chunkSize = 4 * 1024 * 1024;
+    static const int _metadataSize = 1024 * 1024;
+
+    bool _prepare(QString cachePath, QStringList partitions, QString imageName);
+    void _abort(bool keepCacheMounted);
+    void _release();
+
+    void _preReadPartition(const QString& partition);
+    ImageCheck _verifyImage(const QString& imagePath);
+};
+
+#endif // LINBOAUTOSTARTPREPARATION_H
@@ -26,6 +26,7 @@
 #include <QTimer>
 #include <QFile>
 #include <QSettings>
+#include <functional>
 
 #include "linbopostprocessactions.h"
 #include "linbologger.h"
@@ -35,6 +36,12 @@
 #include "linbodiskpartition.h"
 #include "linboconfigreader.h"
 #include "linbocmd.h"
+#include "linbojobqueue.h"
+#include "linbocacheupdater.h"
+#include "linbofreshnesschecker.h"
+#include "linbostartjitter.h"
+#include "linboautostartpreparation.h"
+#include "linbocontrolserver.h"
 
 /**
  * @brief The LinboBackend class is used to execute Linbo commands (control linbo_cmd) very comfortable.
@@ -49,11 +56,13 @@ class LinboBackend : public QObject
     Q_PROPERTY(int _timeoutRemainingMilliseconds READ _timeoutRemainingMilliseconds NOTIFY timeoutProgressChanged)
 
 public:
-    explicit LinboBackend(QObject *parent = nullptr);
+    explicit LinboBackend(QObject *parent = nullptr, bool executeAutomaticTasks = true);
 
     friend class LinboImage;
     friend class LinboConfigReader;
     friend class LinboOs;
+    friend class LinboJobQueue;
+    friend class LinboControlServer;
 
     /**
      * @brief The LinboState enum contains all possible states of Linbo
@@ -76,13 +85,18 @@ public:
         Updating,
         RootTimeout,
         RootActionError,    /*!< The last root action failed, the resetMessage() function will reset to Root */
-        RootActionSuccess   /*!< The last root action was successfull, the resetMessage() function will reset to Root */
+        RootActionSuccess,  /*!< The last root action was successfull, the resetMessage() function will reset to Root */
+        SyncingOs           /*!< Sync as a root maintenance job, the os is not started afterwards */
     };
+    Q_ENUM(LinboState)
 
     LinboState state();
     LinboLogger* logger();
     LinboConfig* config();
     LinboOs* osOfCurrentAction();
+    LinboJobQueue* jobQueue();
+    LinboCacheUpdater* cacheUpdater();
+    int remainingAdmissionDelay();
 
     void restartRootTimeout();
 
@@ -95,6 +109,7 @@ public slots:
 
     bool partitionDrive();
     bool updateCache(LinboConfig::DownloadMethod downloadMethod, bool format = false, LinboPostProcessActions::Flags postProcessActions = LinboPostProcessActions::NoAction);
+    bool retryCacheUpdate();
     bool updateLinbo();
     bool registerClient(QString room, QString hostname, QString ipAddress, QString hostGroup, LinboConfig::LinboDeviceRole deviceRole);
 
@@ -128,9 +143,17 @@ private:
     LinboConfig* _config;
     LinboCmd* _linboCmd;
     LinboOs* _osOfCurrentAction;
+    LinboJobQueue* _jobQueue;
+    LinboCacheUpdater* _cacheUpdater;
+    LinboFreshnessChecker* _freshnessChecker;
+    LinboControlServer* _controlServer;
+    LinboAutostartPreparation* _autostartPreparation;
 
     QTimer* _timeoutTimer;
     QTimer* _timeoutRemainingTimeRefreshTimer;
+    QTimer* _admissionTimer;
+    int _admissionDelay;
+    bool _admissionDelayApplied;
 
     QString _rootPassword;
     LinboImage* _imageToUploadAutomatically;
@@ -139,6 +162,7 @@ private:
     QRegularExpression qcwoEndingRegex = QRegularExpression(".qcow2$");
 
     void _setState(LinboState state);
+    bool _canStartRootAction();
     bool _createImageOfOs(LinboOs* os, QString name, QString description = "", LinboPostProcessActions::Flags postProcessActions = LinboPostProcessActions::NoAction);
 
 private slots:
@@ -146,14 +170,31 @@ private slots:
 
     bool _partitionDrive(bool format, LinboPostProcessActions::Flags postProcessActions);
     bool _uploadImage(LinboImage* image, LinboPostProcessActions::Flags postProcessActions);
+    bool _syncOsWithoutStart(LinboOs* os);
+    bool _uploadImageInBackground(LinboImage* image);
+
+    bool _updateCache(LinboConfig::DownloadMethod downloadMethod, bool format, LinboPostProcessActions::Flags postProcessActions);
+    bool _updateCacheForControlClient(LinboConfig::DownloadMethod downloadMethod, bool format);
+
+    bool _executeJob(LinboJob* job);
+    LinboImage* _imageOfJob(LinboJob* job);
+    void _showBackgroundJob(LinboJob* job);
+    void _handleJobQueueFinished(bool successful);
 
     void _executeAutomaticTasks();
     bool _executeAutoPartition();
     bool _executeAutoInitCache();
     LinboOs* _getOsForAutostart();
     bool _executeAutostart();
+    int _takeAdmissionDelay();
+    void _startAutostartPreparation(LinboOs* os);
+    void _finishAutostartPreparation(bool keepCacheMounted);
+    void _logAutostartPreparationResult();
+    bool _runAfterAutostartPreparation(std::function<bool()> action);
+    void _handleAdmissionTimerTimeout();
 
     void _handleCommandFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void _handleBackgroundCommandFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void _handleCommandFinishedSuccess();
     void _handleCommandFinishedError();
     void _executeNextPostProcessAction();
@@ -169,10 +210,13 @@ private slots:
     void _handleTimeoutRemaningTimeRefreshTimerTimeout();
     double _timeoutProgress();
     int _timeoutRemainingMilliseconds();
+    QTimer* _countdownTimer();
 
 signals:
     void stateChanged(LinboBackend::LinboState state);
     void timeoutProgressChanged(double progress, int remaningMilliseconds);
+    // the cache was mounted in the background, LinboCacheMount::acquire() can use it without mounting
+    void cacheMounted();
 
 };
 
@@ -0,0 +1,76 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOCACHEMOUNT_H
+#define LINBOCACHEMOUNT_H
+
+#include <QString>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QProcess>
+#include <QMutex>
+#include <QHash>
+
+/**
+ * @brief The LinboCacheMount class contains helpers to find and mount the cache partition.
+ *
+ * linbo_cmd mounts the cache to /cache itself and leaves it alone when it is already mounted there,
+ * so the GUI uses the same mount point.
+ *
+ * Everything in the GUI that needs the cache (freshness checker, log archive, autostart preparation,
+ * raster cache) shares one reference counted mount through acquire() and release(), from any thread.
+ * The cache is only unmounted once the last reference is released, and only if it was mounted by
+ * acquire() in the first place.
+ */
+class LinboCacheMount
+{
+public:
+    static QString mountPointOf(const QString& device);
+    static QString acquire(const QString& device, bool mountIfNeeded = true);
+    static void release(const QString& device, bool keepMounted = false);
+    static QString imagePath(const QString& mountPoint, const QString& imageName);
+
+    static QString defaultMountPoint() {
+        return _defaultMountPoint;
+    }
+
+private:
+    LinboCacheMount() {}
+
+    typedef struct {
+        QString mountPoint;
+        int references;
+        bool mountedByUs;
+    } _Mount;
+
+    static QMutex _mutex;
+    static QHash<QString, _Mount> _mounts;
+
+    static QString _acquire(const QString& device, bool mountIfNeeded);
+    static QString _mount(const QString& device);
+    static bool _unmount(const QString& mountPoint);
+
+#ifdef TEST_ENV
+    static inline const QString _defaultMountPoint = TEST_ENV;
+#else
+    static inline const QString _defaultMountPoint = "/cache";
+#endif
+};
+
+#endif // LINBOCACHEMOUNT_H
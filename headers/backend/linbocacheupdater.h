@@ -0,0 +1,113 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOCACHEUPDATER_H
+#define LINBOCACHEUPDATER_H
+
+#include <QObject>
+#include <QList>
+#include <QProcess>
+
+#include "linboimage.h"
+#include "linbologger.h"
+#include "linboconfig.h"
+
+class LinboBackend;
+class LinboCmd;
+
+/**
+ * @brief The LinboCacheUpdater class updates the cache with one linbo_cmd process per image.
+ *
+ * Up to InitCacheConcurrency images (1 by default, admins can opt in to more) are downloaded at the same time. An image which fails
+ * is retried on its own up to InitCacheRetries times, the other images are not downloaded again.
+ * When the cache is formatted, the first image runs alone so the cache is only formatted once.
+ * Images which still failed afterwards can be retried using retryFailed().
+ */
+class LinboCacheUpdater : public QObject
+{
+    Q_OBJECT
+public:
+    friend class LinboBackend;
+
+    enum ImageStatus {
+        Waiting,
+        Downloading,
+        Done,
+        Failed
+    };
+    Q_ENUM(ImageStatus)
+
+    LinboImage* image(int index);
+    QString imageName(int index);
+    ImageStatus status(int index);
+    int attempts(int index);
+    QString latestOutput(int index);
+    int count() {
+        return this->_images.length();
+    }
+    int countWithStatus(ImageStatus status);
+
+    bool isRunning() {
+        return this->_running;
+    }
+    bool hasFailedImages() {
+        return this->countWithStatus(Failed) > 0;
+    }
+
+    static QString statusToString(ImageStatus status);
+
+private:
+    explicit LinboCacheUpdater(LinboCmd* linboCmd, LinboLogger* logger, LinboBackend* backend);
+
+    typedef struct {
+        LinboImage* image;
+        ImageStatus status;
+        int attempts;
+        QString latestOutput;
+        QProcess* process;
+    } ImageState;
+
+    LinboCmd* _linboCmd;
+    LinboLogger* _logger;
+    QList<ImageState> _images;
+    bool _running;
+    bool _format;
+    LinboConfig::DownloadMethod _downloadMethod;
+    QString _serverIP;
+    QString _cachePath;
+    int _concurrency;
+    int _maxAttempts;
+
+    bool _start(LinboConfig::DownloadMethod downloadMethod, bool format, QList<LinboImage*> images, QString serverIP, QString cachePath, int concurrency, int retries);
+    bool _retryFailed();
+    void _kill();
+
+    void _startNextImages();
+    bool _startImage(int index);
+    void _readOutput(int index, bool stdErr);
+    void _handleImageFinished(int index, bool successful);
+    void _setStatus(int index, ImageStatus status);
+    int _indexOf(QProcess* process);
+
+signals:
+    void imageStatusChanged(int index);
+    void progressChanged(int index);
+    void finished(bool successful);
+};
+
+#endif // LINBOCACHEUPDATER_H
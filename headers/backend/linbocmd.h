@@ -20,16 +20,18 @@ public:
 
     bool startOs(LinboOs* os, QString cachePath);
     bool syncOs(LinboOs* os, QString serverIP, QString cachePath);
+    bool syncOsWithoutStart(LinboOs* os, QString serverIP, QString cachePath);
     bool reinstallOs(LinboOs* os, QString serverIP, QString cachePath);
 
     bool createImageOfOs(LinboOs* os, QString name, QString cachePath);
 
     bool partitionDrive(QList<LinboDiskPartition*> paritions, bool format);
-    bool uploadImage(LinboImage *image, QString password, QString serverIP, QString cachePath);
+    bool uploadImage(LinboImage *image, QString password, QString serverIP, QString cachePath, bool inBackground = false);
 
     bool authenticate(QString password, QString serverIP);
+    QProcess* startAuthentication(QString password, QString serverIP, QObject* parent);
 
-    bool updateCache(LinboConfig::DownloadMethod downloadMethod, bool format, QList<LinboOs*> operaringSystems, QString serverIP, QString cachePath);
+    QProcess* updateCacheOfImage(LinboConfig::DownloadMethod downloadMethod, bool format, LinboImage* image, QString serverIP, QString cachePath, QObject* parent);
     bool updateLinbo(QString serverIP, QString cachePath);
     bool registerClient(QString room, QString hostname, QString ipAddress, QString hostGroup, LinboConfig::LinboDeviceRole deviceRole, QString password, QString serverIP);
 
@@ -38,6 +40,8 @@ public:
         return this->executeAsync(this->_buildCommand(argument, arguments ...));
     }
     bool executeAsync(QStringList arguments);
+    bool executeAsyncInBackground(QStringList arguments);
+    QProcess* startProcess(QStringList arguments, QObject* parent);
 
     template<typename ... Strings>
     int executeSync(QString argument, const Strings&... arguments) {
@@ -59,6 +63,8 @@ public:
 
     void setStringToMaskInOutput(QString string);
     void killAsyncProcess();
+    void killBackgroundProcess();
+    bool isBackgroundProcessRunning();
 
 protected:
 
@@ -66,6 +72,8 @@ protected:
 private:
     LinboLogger* _logger;
     QProcess* _asynchronosProcess;
+    // a second asynchronos process for a command which runs next to the current one
+    QProcess* _backgroundProcess;
     QProcess* _synchronosProcess;
 
     QString _stringToMaskInOutput;
@@ -104,9 +112,12 @@ private:
 private slots:
     void _readFromStdout();
     void _readFromStderr();
+    void _readFromBackgroundStdout();
+    void _readFromBackgroundStderr();
 
 signals:
     void commandFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void backgroundCommandFinished(int exitCode, QProcess::ExitStatus exitStatus);
 };
 
 #endif // LINBOCMD_H
@@ -35,6 +35,7 @@ class LinboConfig : public QObject
     Q_OBJECT
 public:
     friend class LinboConfigReader;
+    friend class LinboBackend;
 
     enum DownloadMethod {
         Rsync,
@@ -116,6 +117,54 @@ public:
     const QString& themeName() const {
         return this->_themeName;
     }
+    bool logArchiveEnabled() const {
+        return this->_logArchiveEnabled;
+    }
+    int logArchiveMaxSize() const {
+        return this->_logArchiveMaxSize;
+    }
+    int logArchiveMaxAge() const {
+        return this->_logArchiveMaxAge;
+    }
+    const QString& logConsole() const {
+        return this->_logConsole;
+    }
+    const QString& logFile() const {
+        return this->_logFile;
+    }
+    const QString& logHistory() const {
+        return this->_logHistory;
+    }
+    const QString& logStructured() const {
+        return this->_logStructured;
+    }
+    int initCacheConcurrency() const {
+        return this->_initCacheConcurrency;
+    }
+    int initCacheRetries() const {
+        return this->_initCacheRetries;
+    }
+    int freshnessCheckInterval() const {
+        return this->_freshnessCheckInterval;
+    }
+    bool preDownload() const {
+        return this->_preDownload;
+    }
+    int preDownloadBandwidthLimit() const {
+        return this->_preDownloadBandwidthLimit;
+    }
+    int autostartJitter() const {
+        return this->_autostartJitter;
+    }
+    int autostartWindow() const {
+        return this->_autostartWindow;
+    }
+    const QString& controlSocket() const {
+        return this->_controlSocket;
+    }
+    int animationFramesPerSecond() const {
+        return this->_animationFramesPerSecond;
+    }
 
     QMap<QString, LinboImage*> images() {
         return this->_images;
@@ -167,6 +216,22 @@ private:
     bool _autoFormat;
     bool _guiDisabled;
     bool _clientDetailsVisibleByDefault;
+    bool _logArchiveEnabled;
+    int _logArchiveMaxSize;
+    int _logArchiveMaxAge;
+    QString _logConsole;
+    QString _logFile;
+    QString _logHistory;
+    QString _logStructured;
+    int _initCacheConcurrency;
+    int _initCacheRetries;
+    int _freshnessCheckInterval;
+    bool _preDownload;
+    int _preDownloadBandwidthLimit;
+    int _autostartJitter;
+    int _autostartWindow;
+    QString _controlSocket;
+    int _animationFramesPerSecond;
 
 signals:
 
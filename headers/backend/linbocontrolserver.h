@@ -0,0 +1,135 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOCONTROLSERVER_H
+#define LINBOCONTROLSERVER_H
+
+#include <QObject>
+#include <QSocketNotifier>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QList>
+#include <QProcess>
+#include <QDeadlineTimer>
+
+#include "linbologger.h"
+#include "linbojob.h"
+#include "linboactivitymonitor.h"
+
+class LinboBackend;
+
+/**
+ * @brief The LinboControlServer class exposes the backend on a local unix domain socket.
+ *
+ * Every connected client receives newline delimited json: state changes, log lines and progress
+ * records (autostart countdown, cache update, jobs). A client can send one json object per line:
+ *
+ *  {"command": "state"}
+ *  {"command": "start" | "sync" | "reinstall", "os": "<name>"}
+ *  {"command": "cancel"}
+ *  {"command": "login", "password": "<password>"}
+ *  {"command": "initcache", "method": "rsync" | "multicast" | "torrent"}
+ *  {"command": "logout"}
+ *  {"command": "activity"}
+ *
+ * The activity command reports paint events and event loop wakeups per second since the previous
+ * activity command of the same connection (or since it connected). The counting starts when the
+ * server starts listening.
+ *
+ * Each command is answered with {"type": "reply", "command": .., "ok": ..}. Root actions (initcache,
+ * logout and cancelling one of them) are only accepted after a successful login on the same connection.
+ * The login only applies to that connection, the gui stays where it is. It ends with the logout command
+ * and whenever the backend goes back to Idle (eg. after the cache update or when the gui logs out).
+ * Only one login is checked at a time and after a failed one, no login is accepted for a few seconds.
+ *
+ * All sockets are non-blocking. Output a client does not read is buffered up to a limit, after that its
+ * log and progress records are dropped (and counted in a "dropped" record once it catches up) and
+ * eventually it is disconnected, so a slow client never slows down the backend.
+ */
+class LinboControlServer : public QObject
+{
+    Q_OBJECT
+public:
+    friend class LinboBackend;
+
+    ~LinboControlServer();
+
+    bool isListening() {
+        return this->_serverSocket >= 0;
+    }
+
+private:
+    explicit LinboControlServer(LinboBackend* backend, LinboLogger* logger);
+
+    typedef struct {
+        int socket;
+        QSocketNotifier* readNotifier;
+        QSocketNotifier* writeNotifier;
+        QByteArray input;
+        QByteArray output;
+        int droppedRecords;
+        bool authenticated;
+        LinboActivityMonitor::Sample activitySample;
+        bool closed;
+    } Client;
+
+    LinboBackend* _backend;
+    LinboLogger* _logger;
+    QString _socketPath;
+    int _serverSocket;
+    QSocketNotifier* _serverNotifier;
+    LinboActivityMonitor* _activityMonitor;
+    QList<Client*> _clients;
+    QList<Client*> _closedClients;
+
+    QProcess* _authentication;
+    Client* _authenticatingClient;
+    QDeadlineTimer _loginDelay;
+
+    static const int _failedLoginDelay = 3000;
+    static const int _droppingThreshold = 512 * 1024;
+    static const int _disconnectThreshold = 4 * 1024 * 1024;
+    static const int _maxLineLength = 64 * 1024;
+
+    bool _listen(QString socketPath);
+    void _close();
+
+    void _acceptClients();
+    void _readFromClient(Client* client);
+    void _writeToClient(Client* client);
+    void _disconnectClient(Client* client);
+    void _deleteClosedClients();
+
+    void _handleCommand(Client* client, const QJsonObject& command);
+    void _reply(Client* client, QString command, bool ok, QString error = "");
+    void _authenticate(Client* client, QString password);
+    void _handleAuthenticationFinished(bool successful);
+
+    void _broadcast(const QJsonObject& record, bool droppable);
+    void _send(Client* client, const QJsonObject& record, bool droppable);
+    QJsonObject _stateRecord();
+
+private slots:
+    void _handleStateChanged(int state);
+    void _handleLatestLogChanged(const LinboLogger::LinboLog& latestLog);
+    void _handleTimeoutProgressChanged(double progress, int remainingMilliseconds);
+    void _handleCacheImageChanged(int index);
+    void _handleJobStatusChanged(LinboJob* job);
+};
+
+#endif // LINBOCONTROLSERVER_H
@@ -0,0 +1,107 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOFRESHNESSCHECKER_H
+#define LINBOFRESHNESSCHECKER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QStorageInfo>
+#include <QDir>
+
+#include "linboimage.h"
+#include "linbologger.h"
+#include "linboconfig.h"
+
+class LinboBackend;
+
+/**
+ * @brief The LinboFreshnessChecker class checks if the cached images are still up to date while Linbo is idle.
+ *
+ * Every FreshnessCheckInterval minutes, the .info and .md5 files of all base images are fetched from the server
+ * and compared to the ones in the cache. The result is stored in LinboImage::freshness().
+ *
+ * When PreDownload is enabled, stale images are then downloaded with a bandwidth limit into a staging
+ * directory on the cache partition and swapped in once they are complete, so the next sync only has
+ * to apply them locally.
+ *
+ * Everything runs with idle io and cpu priority and is paused as soon as Linbo leaves the Idle state.
+ * A paused check or download continues with the image it was interrupted at.
+ */
+class LinboFreshnessChecker : public QObject
+{
+    Q_OBJECT
+public:
+    friend class LinboBackend;
+
+    bool isRunning() {
+        return this->_process != nullptr;
+    }
+
+private:
+    explicit LinboFreshnessChecker(LinboBackend* backend, LinboLogger* logger, LinboConfig* config);
+
+    LinboBackend* _backend;
+    LinboLogger* _logger;
+    LinboConfig* _config;
+    QTimer* _timer;
+    QElapsedTimer _sinceLastRound;
+    QProcess* _process;
+    QTemporaryDir* _stagingDir;
+    QList<LinboImage*> _pendingImages;
+    QList<LinboImage*> _imagesToDownload;
+    QMap<LinboImage*, qint64> _remoteImageSizes;
+    LinboImage* _currentImage;
+    bool _downloading;
+    QString _mountPoint;
+
+    static const int _startDelay = 60 * 1000;
+
+    void _resume();
+    void _pause();
+    void _startRound();
+    void _checkNextImage();
+    void _downloadNextImage();
+    void _startProcess(QStringList arguments);
+    void _handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    LinboImage::ImageFreshness _compare(LinboImage* image);
+    bool _swapInStagedImage(LinboImage* image);
+    void _finishRound();
+    void _pruneStagingDirectories();
+    void _releaseCache();
+
+    QString _localImagePath(LinboImage* image);
+    QString _remoteImagePath(LinboImage* image);
+    QString _stagingPath(LinboImage* image);
+    static QString _baseName(LinboImage* image);
+    static QByteArray _readFile(QString path);
+
+private slots:
+    void _handleBackendStateChanged(int state);
+
+signals:
+    void cacheMounted();
+
+};
+
+#endif // LINBOFRESHNESSCHECKER_H
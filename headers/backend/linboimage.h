@@ -37,6 +37,18 @@ public:
     friend class LinboConfigReader;
     friend class LinboBackend;
     friend class LinboOs;
+    friend class LinboFreshnessChecker;
+
+    /**
+     * @brief The ImageFreshness enum contains the result of the last comparison with the server
+     */
+    enum ImageFreshness {
+        UnknownFreshness,   /*!< Not checked yet or the server could not be reached */
+        Fresh,
+        Stale,              /*!< The server has a different version of the image */
+        Missing             /*!< The image is not in the cache */
+    };
+    Q_ENUM(ImageFreshness)
 
     QString getDescription();
     bool upload(LinboPostProcessActions::Flags postProcessActions);
@@ -53,6 +65,9 @@ public:
     bool existsOnDisk() {
         return this->_existsOnDisk;
     }
+    ImageFreshness freshness() {
+        return this->_freshness;
+    }
 
 protected:
     explicit LinboImage(QString name, LinboBackend *parent = nullptr);
@@ -64,6 +79,12 @@ private:
     LinboOs* _os;
     QString _name;
     bool _existsOnDisk;
+    ImageFreshness _freshness;
+
+    void _setFreshness(ImageFreshness freshness);
+
+signals:
+    void freshnessChanged(LinboImage::ImageFreshness freshness);
 };
 
 #endif // LINBOIMAGE_H
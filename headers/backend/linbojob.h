@@ -0,0 +1,166 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOJOB_H
+#define LINBOJOB_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QRegularExpression>
+
+#include "linboconfig.h"
+#include "linboos.h"
+
+/**
+ * @brief The LinboJob class describes one step of an unattended root maintenance run.
+ *
+ * Jobs are executed one after another by the LinboJobQueue.
+ * A job which fails either aborts the queue or lets it continue, depending on its failure policy.
+ */
+class LinboJob : public QObject
+{
+    Q_OBJECT
+public:
+    friend class LinboJobQueue;
+
+    enum JobType {
+        CreateBaseImageJob,
+        CreateDiffImageJob,
+        UploadImageJob,
+        SyncOsJob,
+        InitCacheJob,
+        PartitionDriveJob
+    };
+    Q_ENUM(JobType)
+
+    enum JobStatus {
+        Pending,
+        Running,
+        Succeeded,
+        Failed,
+        Cancelled,
+        Skipped     /*!< A previous job failed and aborted the queue */
+    };
+    Q_ENUM(JobStatus)
+
+    enum FailurePolicy {
+        AbortOnFailure,
+        ContinueOnFailure
+    };
+    Q_ENUM(FailurePolicy)
+
+    /**
+     * @brief What a job is busy with. In pipelined mode, jobs which do not share
+     * a resource class may run at the same time.
+     */
+    enum ResourceClass {
+        NoResource = 0,
+        DiskResource = 1,
+        NetworkResource = 2
+    };
+    Q_DECLARE_FLAGS(ResourceClasses, ResourceClass)
+    Q_FLAG(ResourceClasses)
+
+    explicit LinboJob(JobType type, LinboOs* os = nullptr, QObject* parent = nullptr);
+
+    JobType type() {
+        return this->_type;
+    }
+    LinboOs* os() {
+        return this->_os;
+    }
+    JobStatus status() {
+        return this->_status;
+    }
+    FailurePolicy failurePolicy() {
+        return this->_failurePolicy;
+    }
+    void setFailurePolicy(FailurePolicy failurePolicy) {
+        this->_failurePolicy = failurePolicy;
+    }
+    ResourceClasses resourceClasses();
+    bool dependsOn(LinboJob* job);
+    bool runsInBackground() {
+        return this->_runsInBackground;
+    }
+
+    // Image description for CreateBaseImageJob and CreateDiffImageJob
+    const QString& description() {
+        return this->_description;
+    }
+    void setDescription(QString description) {
+        this->_description = description;
+    }
+
+    // Image to upload for UploadImageJob, the base image of the os by default
+    QString imageName();
+    void setImageName(QString imageName) {
+        this->_imageName = imageName;
+    }
+
+    // Options of InitCacheJob and PartitionDriveJob
+    LinboConfig::DownloadMethod downloadMethod() {
+        return this->_downloadMethod;
+    }
+    void setDownloadMethod(LinboConfig::DownloadMethod downloadMethod) {
+        this->_downloadMethod = downloadMethod;
+    }
+    bool format() {
+        return this->_format;
+    }
+    void setFormat(bool format) {
+        this->_format = format;
+    }
+
+    const QDateTime& startedAt() {
+        return this->_startedAt;
+    }
+    const QDateTime& finishedAt() {
+        return this->_finishedAt;
+    }
+    qint64 durationMs();
+
+    QString toString();
+    static QString typeToString(JobType type);
+    static JobType stringToType(const QString& type, bool* ok = nullptr);
+    static QString statusToString(JobStatus status);
+
+private:
+    JobType _type;
+    LinboOs* _os;
+    JobStatus _status;
+    FailurePolicy _failurePolicy;
+
+    QString _description;
+    QString _imageName;
+    LinboConfig::DownloadMethod _downloadMethod;
+    bool _format;
+    bool _runsInBackground;
+
+    QDateTime _startedAt;
+    QDateTime _finishedAt;
+
+    void _setStatus(JobStatus status);
+
+signals:
+    void statusChanged(LinboJob::JobStatus status);
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(LinboJob::ResourceClasses)
+
+#endif // LINBOJOB_H
@@ -0,0 +1,103 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOJOBQUEUE_H
+#define LINBOJOBQUEUE_H
+
+#include <QObject>
+#include <QList>
+
+#include "linbojob.h"
+#include "linbologger.h"
+#include "linbopostprocessactions.h"
+
+class LinboBackend;
+
+/**
+ * @brief The LinboJobQueue class runs a list of LinboJobs without user interaction.
+ *
+ * The queue can only be started in the Root state. While it is running, the backend
+ * stays in the state of the current job and only reports RootActionSuccess or
+ * RootActionError once all jobs are done. The post process actions (shutdown, reboot, logout)
+ * are executed after the last job when no job failed.
+ *
+ * By default, the jobs run one after another. In pipelined mode, a job which only uses the
+ * network runs in the background while the next disk bound job runs in the foreground.
+ * At most one job per resource class runs at a time and jobs of the same resource class
+ * keep their order. Uploads use the cache as well, so they do not overlap with creating images.
+ */
+class LinboJobQueue : public QObject
+{
+    Q_OBJECT
+public:
+    friend class LinboBackend;
+
+    const QList<LinboJob*>& jobs() {
+        return this->_jobs;
+    }
+    LinboJob* currentJob();
+    LinboJob* backgroundJob();
+    bool isRunning() {
+        return this->_running;
+    }
+    bool hasFailedJobs();
+
+    bool append(LinboJob* job);
+    bool clear();
+
+    void setPostProcessActions(LinboPostProcessActions::Flags postProcessActions);
+    LinboPostProcessActions::Flags postProcessActions() {
+        return this->_postProcessActions;
+    }
+
+    bool setPipelined(bool pipelined);
+    bool pipelined() {
+        return this->_pipelined;
+    }
+
+public slots:
+    bool start();
+    bool abort();
+
+private:
+    explicit LinboJobQueue(LinboBackend* backend, LinboLogger* logger);
+
+    LinboBackend* _backend;
+    LinboLogger* _logger;
+    QList<LinboJob*> _jobs;
+    bool _running;
+    bool _pipelined;
+    bool _aborting;
+    LinboPostProcessActions::Flags _postProcessActions;
+
+    void _startNextJobs();
+    bool _startJob(LinboJob* job, bool inBackground);
+    bool _canStartJob(LinboJob* job);
+    bool _isFinished(LinboJob* job);
+    QList<LinboJob*> _runningJobs();
+    void _handleJobFinished(LinboJob* job, bool successful);
+    void _skipPendingJobs();
+    void _finish();
+
+signals:
+    void jobStatusChanged(LinboJob* job);
+    void runningChanged(bool running);
+    void finished(bool successful);
+};
+
+#endif // LINBOJOBQUEUE_H
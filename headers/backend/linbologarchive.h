@@ -0,0 +1,88 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOLOGARCHIVE_H
+#define LINBOLOGARCHIVE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include "linbocachemount.h"
+
+/**
+ * @brief The LinboLogArchive class keeps compressed copies of the log on the cache partition.
+ *
+ * Every boot gets its own series of segments, which are rotated by size and pruned by age and total size.
+ * A segment consists of a magic header and zlib compressed blocks, each prefixed with its length.
+ * A truncated last block (eg. after a power loss) only loses that block.
+ *
+ * The archive is not thread safe, it is driven by the LinboLogWriter thread.
+ * Compressed blocks stay in memory until sync() finds the cache partition mounted,
+ * the file is never kept open, so linbo_cmd can always unmount the cache.
+ */
+class LinboLogArchive
+{
+public:
+    typedef struct {
+        QString path;
+        QDateTime begin;
+        QDateTime end;
+        qint64 size;
+    } Segment;
+
+    LinboLogArchive(QString cacheDevice, qint64 maxTotalSize, int maxAgeDays);
+
+    void append(const QByteArray& data);
+    bool sync(bool mountIfNeeded);
+
+    static QString directoryOf(QString mountPoint);
+    static QList<Segment> segments(QString directory, QDateTime from = QDateTime(), QDateTime to = QDateTime());
+    static QByteArray readSegment(QString path);
+
+private:
+    QString _cacheDevice;
+    QDateTime _bootTime;
+    int _segmentIndex;
+    qint64 _maxTotalSize;
+    int _maxAgeDays;
+
+    QByteArray _pendingData;
+    QList<QByteArray> _compressedBlocks;
+    qint64 _compressedBlocksSize;
+
+    static const int _blockSize = 256 * 1024;
+    static const qint64 _maxSegmentSize = 1024 * 1024;
+    static const qint64 _maxUnsyncedSize = 8 * 1024 * 1024;
+    static inline const QByteArray _magic = QByteArrayLiteral("LINBOLZ1");
+
+    void _compressPendingData();
+    bool _writeCompressedBlocks(QString directory);
+    void _prune(QString directory);
+    QString _segmentPath(QString directory);
+
+    static QList<QFileInfo> _segmentFiles(QString directory);
+    static QDateTime _bootTimeOfSegment(const QFileInfo& segmentFile);
+};
+
+#endif // LINBOLOGARCHIVE_H
@@ -24,6 +24,11 @@
 #include <QDateTime>
 #include <QFile>
 #include <QStringList>
+#include <QDeadlineTimer>
+
+#include "linbologwriter.h"
+#include "linboringbuffer.h"
+#include "linbostructuredlog.h"
 
 class LinboLogger : public QObject
 {
@@ -34,6 +39,11 @@ public:
     friend class LinboBackend;
     friend class LinboCmd;
     friend class LinboConfigReader;
+    friend class LinboCli;
+    friend class LinboJobQueue;
+    friend class LinboCacheUpdater;
+    friend class LinboFreshnessChecker;
+    friend class LinboControlServer;
 
     enum LinboLogType {
         UnknownLogType = -1,
@@ -51,37 +61,92 @@ public:
         QString message;
         LinboLogType type;
         QDateTime time;
+        quint32 chapter;
     } LinboLog;
 
+    typedef LinboRingBuffer<LinboLog>::View LinboLogView;
+
+    /**
+     * @brief The sinks every log entry can go to. Each one accepts its own set of log types.
+     *
+     * Configured in start.conf ([LINBO] LogConsole, LogFile, LogHistory, LogStructured)
+     * or the environment (LINBO_LOG_CONSOLE, ...), the environment wins.
+     * The value is a comma separated list of a level (verbose, info, error, off)
+     * and additional types (stdout, stderr, chapter), eg. "error,chapter".
+     */
+    enum LinboLogSink {
+        ConsoleSink,
+        FileSink,
+        HistorySink,
+        StructuredSink,
+        LogSinkCount
+    };
+
     const LinboLog& getLatestLog();
 
     static QString logTypeToString(LinboLogType logType);
-    QList<LinboLog> logs();
-    QList<LinboLog> logsOfCurrentChapter();
-    static QList<LinboLog> filteredLogs(QList<LinboLog> logs, LinboLogTypes filterType);
-    static QStringList logsToStacktrace(QList<LinboLog> logs, int limit = -1);
+    static LinboLogTypes stringToLogTypes(QString logTypes, bool* ok = nullptr);
+    static QString logTypesToString(LinboLogTypes logTypes);
+    static LinboLogTypes stringToSinkLogTypes(QString sinkConfig, bool* ok = nullptr);
+    static QString logSinkToString(LinboLogSink sink);
+    LinboLogTypes sinkLogTypes(LinboLogSink sink);
+    LinboLogView logs();
+    LinboLogView logsOfCurrentChapter();
+    // The beginning of a long chapter may already be evicted from logsOfCurrentChapter()
+    QString currentChapterTitle();
+    QList<LinboLog> latestErrors(int count);
+    static QList<LinboLog> filteredLogs(const LinboLogView& logs, LinboLogTypes filterType);
+    static QStringList logsToStacktrace(const LinboLogView& logs, int limit = -1);
 
     void info(QString logText);
     void error(QString logText);
 
+    void flush();
+
 protected slots:
     void chapterBeginning(QString logText);
     void chapterEnd(QString logText);
     void stdErr(QString logText);
     void stdOut(QString logText);
+    // Output of a command running in the background next to the current action (eg. a pipelined upload)
+    void backgroundStdErr(QString logText);
+    void backgroundStdOut(QString logText);
 
 private:
     explicit LinboLogger(QString logFilePath, QObject *parent = nullptr);
 
-    void _log(QString logText, LinboLogType logType);
-
-    bool _writeToLogFile(QString text);
+    void _log(QString logText, LinboLogType logType, bool background = false);
+    void _enableArchive(LinboLogArchive* archive);
+    void _enableStructuredLog();
+    void _configureSink(LinboLogSink sink, QString sinkConfig);
+    void _setSinkLogTypes(LinboLogSink sink, LinboLogTypes logTypes);
+    void _setLinboState(int state);
+    void _setSourceCommand(QString command);
+    QByteArray _structuredRecord(const LinboLog& log, qint64 monotonicNs);
 
     QString _logFilePath;
-    QList<LinboLog> _logHistory;
+    LinboLogWriter* _logWriter;
+
+    // Older entries are only kept in the log file
+    static const int _logHistoryCapacity = 20000;
+    static const int _errorHistoryCapacity = 256;
+
+    LinboRingBuffer<LinboLog> _logHistory;
+    LinboRingBuffer<quint64> _errorHistory;
+    quint64 _currentChapterBegin;
+    quint64 _currentChapterEnd;
+    quint32 _currentChapter;
+    QString _currentChapterTitle;
+
+    LinboLogTypes _sinkLogTypes[LogSinkCount];
+    bool _sinkConfiguredByEnvironment[LogSinkCount];
+    bool _structuredLogEnabled;
+    int _linboState;
+    QString _sourceCommand;
 
 signals:
     void latestLogChanged(const LinboLogger::LinboLog& latestLog);
+    void latestBackgroundLogChanged(const LinboLogger::LinboLog& latestLog);
 
 };
 
@@ -0,0 +1,90 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOLOGWRITER_H
+#define LINBOLOGWRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QByteArray>
+#include <QFile>
+#include <QDeadlineTimer>
+
+#include "linbologarchive.h"
+#include "linbostructuredlog.h"
+
+/**
+ * @brief The LinboLogWriter class writes log lines to a file from a dedicated thread.
+ *
+ * Lines are appended to an in-memory queue and written in batches through a
+ * file descriptor which stays open for the whole runtime. A batch is written
+ * once it exceeds a size threshold, when it is older than the flush interval
+ * or when a flush is requested explicitly.
+ *
+ * Records of the structured log (see LinboStructuredLog) go through a second queue
+ * into their own file, which is only created once setStructuredLogFile() was called.
+ *
+ * When an archive is set, every batch is also handed to it, and flushes sync it
+ * to the cache partition if the cache is mounted already. flush() only waits for the log files.
+ */
+class LinboLogWriter : public QThread
+{
+    Q_OBJECT
+public:
+    explicit LinboLogWriter(QString logFilePath, QObject *parent = nullptr);
+    ~LinboLogWriter();
+
+    void setArchive(LinboLogArchive* archive);
+
+    void setStructuredLogFile(QString structuredLogFilePath);
+
+    void write(const QString& line);
+    void writeStructured(const QByteArray& record);
+
+    void requestFlush();
+    void flush();
+
+protected:
+    void run() override;
+
+private:
+    QString _logFilePath;
+    QString _structuredLogFilePath;
+
+    QMutex _mutex;
+    QWaitCondition _wakeCondition;
+    QWaitCondition _flushedCondition;
+
+    LinboLogArchive* _archive;
+
+    QByteArray _queue;
+    QByteArray _structuredQueue;
+    bool _flushRequested;
+    bool _stopRequested;
+    quint64 _flushRequestCount;
+    quint64 _flushCount;
+
+    static const int _flushSizeThreshold = 64 * 1024;
+    static const int _flushIntervalMs = 500;
+
+    void _wakeForNewData(bool queuesWereEmpty);
+    void _writeBatch(QFile& logFile, const QByteArray& batch, const QByteArray& header = QByteArray());
+};
+
+#endif // LINBOLOGWRITER_H
@@ -0,0 +1,138 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBORINGBUFFER_H
+#define LINBORINGBUFFER_H
+
+#include <QList>
+#include <QtGlobal>
+
+/**
+ * @brief The LinboRingBuffer class is a fixed-capacity buffer which drops its oldest entries when full.
+ *
+ * Every appended entry gets a sequence number which never changes, so callers can
+ * remember positions (eg. the beginning of a chapter) and later get a View on a
+ * range of entries without copying them. Entries which were already dropped are
+ * silently left out of a view.
+ */
+template<typename T>
+class LinboRingBuffer
+{
+public:
+    class View;
+
+    class ConstIterator {
+    public:
+        ConstIterator(const LinboRingBuffer<T>* buffer, quint64 sequence) : _buffer(buffer), _sequence(sequence) {}
+
+        const T& operator*() const { return this->_buffer->at(this->_sequence); }
+        const T* operator->() const { return &this->_buffer->at(this->_sequence); }
+        ConstIterator& operator++() { this->_sequence++; return *this; }
+        bool operator==(const ConstIterator& other) const { return this->_sequence == other._sequence; }
+        bool operator!=(const ConstIterator& other) const { return this->_sequence != other._sequence; }
+
+    private:
+        const LinboRingBuffer<T>* _buffer;
+        quint64 _sequence;
+    };
+
+    /**
+     * @brief A cheap, non-owning view on the entries [begin, end) of a LinboRingBuffer
+     *
+     * Only valid as long as the buffer itself exists.
+     * When the buffer drops entries of the range, they are left out of the view.
+     */
+    class View {
+    public:
+        View() : _buffer(nullptr), _begin(0), _end(0) {}
+        View(const LinboRingBuffer<T>* buffer, quint64 begin, quint64 end) : _buffer(buffer), _begin(begin), _end(end) {}
+
+        qsizetype size() const { return this->_end - this->firstSequence(); }
+        qsizetype length() const { return this->size(); }
+        bool isEmpty() const { return this->size() <= 0; }
+
+        const T& at(qsizetype index) const { return this->_buffer->at(this->firstSequence() + index); }
+        const T& operator[](qsizetype index) const { return this->at(index); }
+        const T& first() const { return this->at(0); }
+        const T& last() const { return this->at(this->size() - 1); }
+
+        quint64 firstSequence() const {
+            if(this->_buffer == nullptr)
+                return this->_end;
+            return qBound(this->_begin, this->_buffer->firstSequence(), this->_end);
+        }
+        quint64 endSequence() const { return this->_end; }
+
+        ConstIterator begin() const { return ConstIterator(this->_buffer, this->firstSequence()); }
+        ConstIterator end() const { return ConstIterator(this->_buffer, this->_end); }
+
+        QList<T> toList() const {
+            QList<T> list;
+            list.reserve(this->size());
+            for(const T& item : *this)
+                list.append(item);
+            return list;
+        }
+
+    private:
+        const LinboRingBuffer<T>* _buffer;
+        quint64 _begin;
+        quint64 _end;
+    };
+
+    explicit LinboRingBuffer(qsizetype capacity) {
+        this->_capacity = qMax<qsizetype>(capacity, 1);
+        this->_nextSequence = 0;
+    }
+
+    qsizetype capacity() const { return this->_capacity; }
+    qsizetype size() const { return this->_items.size(); }
+    bool isEmpty() const { return this->_items.isEmpty(); }
+
+    quint64 firstSequence() const { return this->_nextSequence - this->_items.size(); }
+    quint64 nextSequence() const { return this->_nextSequence; }
+    bool contains(quint64 sequence) const { return sequence >= this->firstSequence() && sequence < this->_nextSequence; }
+
+    const T& at(quint64 sequence) const { return this->_items.at(sequence % this->_capacity); }
+    const T& last() const { return this->at(this->_nextSequence - 1); }
+
+    quint64 append(const T& item) {
+        if(this->_items.size() < this->_capacity)
+            this->_items.append(item);
+        else
+            this->_items[this->_nextSequence % this->_capacity] = item;
+
+        return this->_nextSequence++;
+    }
+
+    View view(quint64 begin, quint64 end) const {
+        end = qMin(end, this->_nextSequence);
+        return View(this, qMin(begin, end), end);
+    }
+
+    View all() const {
+        return View(this, this->firstSequence(), this->_nextSequence);
+    }
+
+private:
+    qsizetype _capacity;
+    quint64 _nextSequence;
+    QList<T> _items;
+};
+
+#endif // LINBORINGBUFFER_H
@@ -0,0 +1,43 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOSTARTJITTER_H
+#define LINBOSTARTJITTER_H
+
+#include <QString>
+
+/**
+ * @brief The LinboStartJitter class spreads network heavy automatic actions of many clients over time.
+ *
+ * The delay is derived from the MAC address, so a client always waits the same time and
+ * the clients of a room are distributed evenly over [0, jitter).
+ * With an admission window, the delay is rounded down to a multiple of the window, so the clients
+ * start in batches every window seconds instead of continuously.
+ */
+class LinboStartJitter
+{
+public:
+    static int delayMilliseconds(const QString& macAddress, int jitterSeconds, int windowSeconds);
+
+private:
+    LinboStartJitter() {}
+
+    static quint32 _hash(const QString& macAddress);
+};
+
+#endif // LINBOSTARTJITTER_H
@@ -0,0 +1,85 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOSTRUCTUREDLOG_H
+#define LINBOSTRUCTUREDLOG_H
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QtEndian>
+#include <cstring>
+
+/**
+ * @brief The LinboStructuredLog class encodes and reads the binary structured log.
+ *
+ * The file starts with a magic and contains one record per log entry.
+ * Every record starts with a fixed size little endian header (see RecordHeader),
+ * followed by the UTF-8 encoded command and message.
+ * Readers can filter on the header and skip the strings of records they are not interested in.
+ */
+class LinboStructuredLog
+{
+public:
+    typedef struct {
+        qint64 monotonicNs;
+        qint64 wallClockMs;
+        qint8 type;
+        qint8 state;
+        quint32 chapter;
+        quint16 commandLength;
+        quint32 messageLength;
+    } RecordHeader;
+
+    static const QByteArray& fileMagic() {
+        return _magic;
+    }
+
+    static QByteArray encode(const RecordHeader& header, const QByteArray& command, const QByteArray& message);
+
+    /**
+     * @brief Sequential reader for structured log files, maps the file into memory
+     */
+    class Reader {
+    public:
+        explicit Reader(QString path);
+        ~Reader();
+
+        bool open();
+        bool atEnd() const;
+
+        bool readHeader(RecordHeader* header);
+        void readStrings(const RecordHeader& header, QString* command, QString* message);
+        void skipStrings(const RecordHeader& header);
+
+    private:
+        QFile _file;
+        const uchar* _data;
+        qint64 _size;
+        qint64 _position;
+    };
+
+    static const int headerSize = 8 + 8 + 1 + 1 + 4 + 2 + 4;
+
+private:
+    LinboStructuredLog() {}
+
+    static inline const QByteArray _magic = QByteArrayLiteral("LINBOSL1");
+};
+
+#endif // LINBOSTRUCTUREDLOG_H
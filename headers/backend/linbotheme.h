@@ -68,6 +68,7 @@ public:
         PartitionIcon,
         RegisterIcon,
         TerminalIcon,
+        LogIcon,
 
         CheckBoxCheckedIcon,
         CheckBoxUncheckedIcon,
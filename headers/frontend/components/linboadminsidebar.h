@@ -23,13 +23,13 @@
 #include <QPainter>
 #include <QPainterPath>
 #include <QPropertyAnimation>
-#include <QSvgRenderer>
 #include <QLinearGradient>
 #include <QFontMetrics>
 #include <QEnterEvent>
 
 #include "linbobackend.h"
 #include "linboguitheme.h"
+#include "linbosvgcache.h"
 
 class LinboAdminSidebarItem : public QWidget
 {
@@ -65,9 +65,7 @@ private:
     QString _label;
     QString _shortLabel;
     LinboTheme::Icon _iconEnum;
-    QSvgRenderer* _svgRenderer;
-    QPixmap _iconCache;
-    int _iconCacheSize;
+    QString _iconPath;
 
     int _expandWidth;
     int _fullExpandedWidth;
@@ -79,8 +77,6 @@ private:
     bool _isItemDisabled;
 
     QPropertyAnimation* _expandAnimation;
-
-    void _ensureIconCache(int size);
 };
 
 
@@ -100,6 +96,7 @@ public:
 
 signals:
     void terminalRequested();
+    void logViewerRequested();
     void cacheUpdateRequested();
     void drivePartitioningRequested();
     void registrationRequested();
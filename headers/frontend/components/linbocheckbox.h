@@ -22,8 +22,11 @@
 #include <QCheckBox>
 #include <QObject>
 #include <QWidget>
+#include <QPainter>
+#include <QPixmap>
 
 #include "linboguitheme.h"
+#include "linbosvgcache.h"
 
 class LinboCheckBox : public QCheckBox
 {
@@ -31,10 +34,24 @@ class LinboCheckBox : public QCheckBox
 public:
     LinboCheckBox(QString label = "", QWidget* parent = nullptr);
 
+    QSize sizeHint() const override;
+
 protected:
     void paintEvent(QPaintEvent *e) override;
+    bool hitButton(const QPoint &pos) const override;
 
 private:
+    static const int _spacing = 6;
+    // room for the focus ring
+    static const int _focusMargin = 2;
+
+    QColor _textColor;
+    QColor _disabledTextColor;
+    QColor _accentColor;
+
+    int _indicatorSize() const;
+    bool _showsFocus() const;
+    QPixmap _indicatorPixmap(bool checked, int size);
 };
 
 #endif // QMODERNCHECKBOX_H
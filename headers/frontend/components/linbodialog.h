@@ -29,6 +29,8 @@
 #include <QPropertyAnimation>
 #include <QtDebug>
 #include <QHBoxLayout>
+#include <QChildEvent>
+#include <QPointer>
 
 #include "linboguitheme.h"
 #include "linbotoolbutton.h"
@@ -51,6 +53,8 @@ protected:
     void resizeEvent(QResizeEvent *e) override;
     void paintEvent(QPaintEvent *e) override;
     void keyPressEvent(QKeyEvent *ev) override;
+    void childEvent(QChildEvent *e) override;
+    bool eventFilter(QObject *watched, QEvent *e) override;
     virtual void setVisibleAnimated(bool visible);
     virtual bool isFrameless();
     void addToolButton(LinboToolButton* toolButton);
@@ -83,7 +87,9 @@ private:
     QHBoxLayout* _bottomToolBarLayout;
     QList<LinboToolButton*> _toolButtons;
 
-    QWidget* _firstChild;
+    QPointer<QWidget> _firstChild;
+    QPointer<QWidget> _lastChild;
+    bool _tabOrderOutdated;
 
     void _initColors();
     void _initModalWidget();
@@ -93,10 +99,10 @@ private:
 
     void _updateToolbarsEnabled();
 
+    void _invalidateTabOrder();
     void _updateTabOrder();
     WidgetPair _updateTabOrderChildren(WidgetPair currentPair);
     WidgetPair _updateTabOrderBottomToolBar(WidgetPair currentPair);
-    void _closeTabOrderCircle(WidgetPair currentPair);
     WidgetPair _updateWidgetTabOrder(QWidget* widget, WidgetPair currentPair);
 
     void _setAllAnimatedWidgetsVisible(bool visible);
@@ -115,6 +121,7 @@ public slots:
 
 private slots:
     void _handleAnimationFinished();
+    void _handleCloseButtonDefocused(Qt::FocusReason reason);
 
 signals:
     void opened();
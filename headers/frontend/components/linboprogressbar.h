@@ -28,6 +28,7 @@
 #include <QPropertyAnimation>
 
 #include "linboguitheme.h"
+#include "linboidlegovernor.h"
 
 class LinboProgressBar : public QProgressBar
 {
@@ -21,7 +21,6 @@
 
 #include <QPushButton>
 #include <QObject>
-#include <QSvgWidget>
 #include <QGraphicsOpacityEffect>
 #include <QResizeEvent>
 #include <QPropertyAnimation>
@@ -37,6 +36,7 @@
 
 #include "linboguitheme.h"
 #include "linbopushbuttonoverlay.h"
+#include "linbosvgwidget.h"
 
 class LinboPushButton : public QAbstractButton
 {
@@ -82,8 +82,8 @@ private:
     QPropertyAnimation* _geometryAnimation;
     QList<LinboPushButtonOverlay*> _overlays;
     QList<LinboPushButtonOverlay::OverlayType> _mutedOverlayTypes;
-    QSvgWidget* _svgIcon;
-    QSvgWidget* _hoveredOverlay;
+    LinboSvgWidget* _svgIcon;
+    LinboSvgWidget* _hoveredOverlay;
     QLabel *_label;
 
     void _initOverlays(QList<LinboPushButtonOverlay*> extraOverlays);
@@ -20,7 +20,6 @@
 #define QMODERNPUSHBUTTONOVERLAY_H
 
 #include <QObject>
-#include <QSvgWidget>
 #include <QGraphicsOpacityEffect>
 #include <QPropertyAnimation>
 #include <QDebug>
@@ -22,6 +22,9 @@
 #include <QRadioButton>
 #include <QObject>
 #include <QWidget>
+#include <QPainter>
+#include <QPixmap>
+#include <QHash>
 
 #include "linboguitheme.h"
 
@@ -31,8 +34,25 @@ class LinboRadioButton : public QRadioButton
 public:
     LinboRadioButton(QString label = "", QWidget* parent = nullptr);
 
+    QSize sizeHint() const override;
+
 protected:
     void paintEvent(QPaintEvent *e) override;
+    bool hitButton(const QPoint &pos) const override;
+
+private:
+    static const int _spacing = 6;
+    // room for the focus ring
+    static const int _focusMargin = 2;
+    static QHash<QString, QPixmap> _indicatorCache;
+
+    QColor _textColor;
+    QColor _disabledTextColor;
+    QColor _accentColor;
+
+    int _indicatorSize() const;
+    bool _showsFocus() const;
+    QPixmap _indicatorPixmap(bool checked, bool enabled, int size);
 };
 
 #endif // QMODERNRADIOBUTTON_H
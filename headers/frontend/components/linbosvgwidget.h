@@ -19,17 +19,33 @@
 #ifndef QMODERNSVGWIDGET_H
 #define QMODERNSVGWIDGET_H
 
-#include <QLabel>
 #include <QObject>
 #include <QWidget>
-#include <QSvgRenderer>
 #include <QPainter>
 
-class LinboSvgWidget : public QLabel
+#include "linbosvgcache.h"
+
+/**
+ * @brief The LinboSvgWidget class shows an svg file from the LinboSvgCache.
+ *
+ * Unlike QSvgWidget, it does not parse and render the file itself, so many widgets showing
+ * the same file at the same size share one pixmap.
+ */
+class LinboSvgWidget : public QWidget
 {
     Q_OBJECT
 public:
+    // fixed height, the width follows the aspect ratio of the file
     LinboSvgWidget(int height, QString path, QWidget* parent = nullptr);
+    // fills the whole widget, like QSvgWidget
+    LinboSvgWidget(QString path, QWidget* parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent *e) override;
+
+private:
+    QString _path;
+    Qt::AspectRatioMode _aspectRatioMode;
 };
 
 #endif // QMODERNSVGWIDGET_H
@@ -29,14 +29,14 @@ class LinboToolButton : public LinboPushButton
 {
     Q_OBJECT
 public:
+    // counts the connections to the close button of a dialog
+    friend class TestLinboDialog;
+
     LinboToolButton(QString text, QWidget* parent = nullptr);
     LinboToolButton(LinboTheme::Icon icon, QWidget* parent = nullptr);
     LinboToolButton(QString text, LinboTheme::Icon icon, QWidget* parent = nullptr);
     LinboToolButton(QString text, LinboTheme::Icon icon, LinboTheme::ColorRole colorRole, QWidget* parent = nullptr);
 
-protected:
-    void paintEvent(QPaintEvent *e) override;
-
 private:
     LinboTheme::ColorRole _colorRole;
 
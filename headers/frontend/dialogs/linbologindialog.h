@@ -26,13 +26,14 @@
 #include <QVBoxLayout>
 #include <QPainter>
 #include <QPainterPath>
-#include <QSvgRenderer>
 #include <QPropertyAnimation>
 #include <QTimer>
 
 #include "linbodialog.h"
+#include "linbosvgcache.h"
 #include "linbolineedit.h"
 #include "linbobackend.h"
+#include "linboidlegovernor.h"
 
 class LinboLoginDialog : public LinboDialog
 {
@@ -48,7 +49,7 @@ protected:
 private:
     LinboBackend* _backend;
     QLineEdit* _passwordInput;
-    QSvgRenderer* _lockRenderer;
+    QString _lockIconPath;
     QHBoxLayout* _mainLayout;
     bool _wrongPassword;
     bool _updatingDisplay;
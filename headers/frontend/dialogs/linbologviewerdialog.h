@@ -0,0 +1,64 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOLOGVIEWERDIALOG_H
+#define LINBOLOGVIEWERDIALOG_H
+
+#include <QObject>
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QListView>
+#include <QScrollBar>
+
+#include "linbodialog.h"
+#include "linbolineedit.h"
+#include "linbocombobox.h"
+#include "linbologmodel.h"
+
+#include "linbobackend.h"
+
+class LinboLogViewerDialog : public LinboDialog
+{
+    Q_OBJECT
+public:
+    LinboLogViewerDialog(LinboBackend* backend, QWidget* parent);
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    LinboBackend* _backend;
+    LinboLogModel* _logModel;
+
+    QVBoxLayout* _mainLayout;
+    LinboLineEdit* _searchEdit;
+    LinboComboBox* _typeFilterBox;
+    LinboComboBox* _chapterFilterBox;
+    QListView* _logView;
+
+    bool _followTail;
+
+private slots:
+    void _refreshChapterList();
+    void _handleChapterAdded(quint32 chapter, QString name);
+    void _handleRowsInserted();
+
+};
+
+#endif // LINBOLOGVIEWERDIALOG_H
@@ -51,9 +51,11 @@ private:
     QLabel* _methodLabel;
     QLabel* _advancedLabel;
     QLabel* _formatWarning;
+    LinboToolButton* _retryButton;
 
 private slots:
     void _updateCache();
+    void _retryFailedImages();
 
 };
 
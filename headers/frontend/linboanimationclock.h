@@ -0,0 +1,70 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOANIMATIONCLOCK_H
+#define LINBOANIMATIONCLOCK_H
+
+#include <QObject>
+#include <QAnimationDriver>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QGuiApplication>
+#include <QScreen>
+
+/**
+ * @brief The LinboAnimationClock class drives all animations of the gui from one timer.
+ *
+ * It replaces the default animation driver of Qt, so every QPropertyAnimation and QVariantAnimation
+ * advances on the same tick and all resulting updates end up in one repaint. The clock ticks at the
+ * refresh rate of the screen (or at a configured cap) and is stopped by Qt as soon as no animation
+ * is running anymore.
+ *
+ * Things which are not animations, but have to be refreshed on every frame while something is animating,
+ * can use the ticked() signal. Things which change at their own pace (eg. a label with the elapsed time)
+ * should use a timer bound to the LinboIdleGovernor instead, the clock only runs while something animates.
+ */
+class LinboAnimationClock : public QAnimationDriver
+{
+    Q_OBJECT
+public:
+    explicit LinboAnimationClock(int framesPerSecond, QObject* parent = nullptr);
+
+    int framesPerSecond() {
+        return this->_framesPerSecond;
+    }
+
+    qint64 elapsed() const override;
+
+protected:
+    void start() override;
+    void stop() override;
+
+private:
+    int _framesPerSecond;
+    QTimer* _tickTimer;
+    QElapsedTimer _elapsedTimer;
+
+    void _handleTick();
+
+signals:
+    void ticked();
+};
+
+extern LinboAnimationClock* gAnimationClock;
+
+#endif // LINBOANIMATIONCLOCK_H
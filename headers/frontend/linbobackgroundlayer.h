@@ -0,0 +1,55 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOBACKGROUNDLAYER_H
+#define LINBOBACKGROUNDLAYER_H
+
+#include <QPainter>
+#include <QPixmap>
+#include <QImage>
+#include <QRegion>
+#include <QLinearGradient>
+
+#include "linboguitheme.h"
+#include "linbosvgcache.h"
+#include "linborenderconfig.h"
+
+/**
+ * @brief The LinboBackgroundLayer class composites the background of the main page.
+ *
+ * The gradient and the logo are painted into one opaque pixmap once per size and effect mode.
+ * The colors of the theme never change at runtime, a change of the size or effect mode is noticed in paint().
+ * A paint event then only copies the exposed region of that pixmap, no gradient or svg is rendered
+ * when eg. a translucent child repaints above it.
+ */
+class LinboBackgroundLayer
+{
+public:
+    explicit LinboBackgroundLayer(const QString& logoPath = "");
+
+    void paint(QPainter* painter, QSize size, const QRegion& region);
+
+private:
+    QString _logoPath;
+    QPixmap _layer;
+    bool _layerLowFxMode;
+
+    void _composite(QSize size);
+};
+
+#endif // LINBOBACKGROUNDLAYER_H
@@ -22,13 +22,13 @@
 #include <QObject>
 #include <QWidget>
 #include <QLabel>
-#include <QSvgWidget>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QtDebug>
 
 #include "linboconfig.h"
 #include "linboguitheme.h"
+#include "linbosvgwidget.h"
 
 class LinboClientInfo : public QWidget
 {
@@ -43,8 +43,8 @@ private:
     QWidget* _mainWidget;
     QGridLayout* _mainLayout;
 
-    QSvgWidget* _networkIconWidget;
-    QSvgWidget* _desktopIconWidget;
+    LinboSvgWidget* _networkIconWidget;
+    LinboSvgWidget* _desktopIconWidget;
 
 signals:
 
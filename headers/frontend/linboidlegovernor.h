@@ -0,0 +1,69 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOIDLEGOVERNOR_H
+#define LINBOIDLEGOVERNOR_H
+
+#include <QObject>
+#include <QWidget>
+#include <QEvent>
+#include <QTimer>
+#include <QAbstractAnimation>
+#include <QList>
+
+/**
+ * @brief The LinboIdleGovernor class suspends animations and timers nobody can see.
+ *
+ * An animation or timer is bound to the widget it draws on. As long as that widget is hidden (eg. on
+ * an inactive page of a stacked widget, or the window is minimized), the animation is paused and the
+ * timer is stopped, so the animation clock and the event loop can sleep. Both are resumed as soon as
+ * the widget is shown again. An animation started while its widget is hidden is paused right away.
+ */
+class LinboIdleGovernor : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LinboIdleGovernor(QObject* parent = nullptr);
+
+    void bindAnimation(QAbstractAnimation* animation, QWidget* target);
+    void bindTimer(QTimer* timer, QWidget* target);
+
+    int suspendedCount();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    typedef struct {
+        QWidget* target;
+        QAbstractAnimation* animation;
+        QTimer* timer;
+        bool suspended;
+    } _Binding;
+
+    QList<_Binding> _bindings;
+
+    void _bind(_Binding binding);
+    void _suspend(_Binding& binding);
+    void _resume(_Binding& binding);
+    void _removeBindingsOf(QObject* object);
+};
+
+extern LinboIdleGovernor* gIdleGovernor;
+
+#endif // LINBOIDLEGOVERNOR_H
@@ -0,0 +1,85 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOLOGMODEL_H
+#define LINBOLOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QObject>
+#include <QTimer>
+#include <QColor>
+
+#include "linbologger.h"
+#include "linboguitheme.h"
+
+/**
+ * @brief The LinboLogModel class is a list model over the log history of a LinboLogger.
+ *
+ * It does not copy any log entries, it only keeps the sequence numbers of the
+ * entries which match the current filter. New entries are appended in batches
+ * and entries which were dropped from the history are removed from the top.
+ */
+class LinboLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum LinboLogModelRole {
+        LogTypeRole = Qt::UserRole,
+        ChapterRole
+    };
+
+    explicit LinboLogModel(LinboLogger* logger, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    void setTypeFilter(LinboLogger::LinboLogTypes types);
+    LinboLogger::LinboLogTypes typeFilter();
+    void setChapterFilter(qint64 chapter);
+    qint64 chapterFilter();
+    void setSearchText(QString searchText);
+    QString searchText();
+
+    QList<QPair<quint32, QString>> chapters();
+
+public slots:
+    void refresh();
+
+private:
+    LinboLogger* _logger;
+    QList<quint64> _sequences;
+    quint64 _nextSequence;
+    QTimer* _appendTimer;
+
+    LinboLogger::LinboLogTypes _typeFilter;
+    // -1 means all chapters
+    qint64 _chapterFilter;
+    QString _searchText;
+
+    bool _matches(const LinboLogger::LinboLog& log) const;
+    void _dropEvictedRows();
+
+private slots:
+    void _handleLatestLogChanged(const LinboLogger::LinboLog& latestLog);
+    void _appendNewLogs();
+
+signals:
+    void chapterAdded(quint32 chapter, QString name);
+};
+
+#endif // LINBOLOGMODEL_H
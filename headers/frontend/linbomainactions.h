@@ -25,6 +25,8 @@
 #include <QStackedWidget>
 #include <QList>
 #include <QLabel>
+#include <QVariantAnimation>
+#include <QTimer>
 
 #include "linbostackedwidget.h"
 #include "linbopushbutton.h"
@@ -39,6 +41,7 @@
 #include "linboupdatecachedialog.h"
 #include "linboimagecreationdialog.h"
 #include "linbotextbrowser.h"
+#include "linboidlegovernor.h"
 
 class LinboMainActions : public QWidget
 {
@@ -57,9 +60,13 @@ private:
     QWidget* _progressBarWidget;
     LinboProgressBar* _progressBar;
     QLabel* _logLabel;
+    QLabel* _backgroundLogLabel;
     QLabel* _passedTimeLabel;
-    QTimer* _passedTimeTimer;
+    bool _passedTimeShown;
+    int _passedSeconds;
     double _processStartedAt;
+    QTimer* _passedTimeTimer;
+    QVariantAnimation* _countdownAnimation;
     LinboPushButton* _cancelButton;
 
     QWidget* _messageWidget;
@@ -77,7 +84,13 @@ private slots:
     void _handleCurrentOsChanged(LinboOs* newOs);
     void _handleLinboStateChanged(LinboBackend::LinboState newState);
     void _handleLatestLogChanged(const LinboLogger::LinboLog& latestLog);
+    void _handleLatestBackgroundLogChanged(const LinboLogger::LinboLog& latestLog);
+    void _updateBackgroundLogLabel();
+    void _updateCacheProgressLabel();
     void _handleTimeoutProgressChanged(double progress, int remaningMilliseconds);
+    void _updatePassedTimeLabel();
+    void _showCountdown();
+    void _showPassedTime();
 
 signals:
 
@@ -27,7 +27,6 @@
 #include <QProgressBar>
 #include <QInputDialog>
 #include <QPropertyAnimation>
-#include <QSvgRenderer>
 #include <QPainter>
 #include <QLinearGradient>
 #include <QRadialGradient>
@@ -39,11 +38,15 @@
 #include "linboosselectionrow.h"
 #include "linbomainactions.h"
 #include "linbosvgwidget.h"
+#include "linbosvgcache.h"
+#include "linbobackgroundlayer.h"
+#include "linborenderconfig.h"
 #include "linboadminsidebar.h"
 #include "linboclientinfosidebar.h"
 
 #include "linbologindialog.h"
 #include "linboimageuploaddialog.h"
+#include "linbologviewerdialog.h"
 
 class LinboMainPage : public QWidget
 {
@@ -66,10 +69,11 @@ private:
 
     QWidget* _headerWidget;
     QLabel* _titleLabel;
-    QSvgRenderer* _edulutionLogoRenderer;
+    LinboBackgroundLayer _backgroundLayer;
 
     LinboLoginDialog* _loginDialog;
     LinboTerminalDialog* _terminalDialog;
+    LinboLogViewerDialog* _logViewerDialog;
     LinboConfirmationDialog* _confirmationDialog;
     LinboRegisterDialog* _registerDialog;
     LinboUpdateCacheDialog* _updateCacheDialog;
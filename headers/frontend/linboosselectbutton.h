@@ -27,10 +27,10 @@
 #include <QEventLoop>
 #include <QLabel>
 #include <QPainter>
-#include <QSvgRenderer>
 #include <QEnterEvent>
 
 #include "linbopushbutton.h"
+#include "linbosvgcache.h"
 #include "linboos.h"
 #include "linbobackend.h"
 
@@ -65,7 +65,7 @@ private:
     QList<LinboPushButton*> _rootActionButtons;
     LinboPushButton* _primaryStartPill;
     LinboPushButton* _primaryRootPill;
-    QSvgRenderer* _iconRenderer;
+    QString _iconPath;
     QLabel* _osNameLabel;
 
 private slots:
@@ -73,6 +73,7 @@ private slots:
     void _updateActionButtonVisibility(bool doNotAnimate = false);
     void _handlePrimaryButtonClicked();
     QString _getTooltipContentForAction(LinboOs::LinboOsStartAction action);
+    void _handleFreshnessChanged();
 
 signals:
     void imageCreationRequested(LinboOs* os);
@@ -0,0 +1,62 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBORENDERCONFIG_H
+#define LINBORENDERCONFIG_H
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QImage>
+#include <QWidget>
+
+/**
+ * @brief The LinboRenderConfig class matches cached layers to the pixel format of the framebuffer.
+ *
+ * linuxfb reports the depth of the framebuffer as the depth of the screen, which is 16 for RGB565
+ * and 24 or 32 for XRGB8888. Opaque layers are kept in the format of the framebuffer, so flushing
+ * them is a plain copy, and layers with alpha are kept premultiplied, so they are blended without
+ * being converted first.
+ */
+class LinboRenderConfig
+{
+public:
+    static int framebufferDepth();
+
+    static QImage::Format opaqueFormat();
+    static QImage::Format translucentFormat();
+
+    static QImage toOpaqueFormat(const QImage& image);
+    static QImage toTranslucentFormat(const QImage& image);
+
+    static void setOpaque(QWidget* widget);
+
+    /**
+     * @brief Turns the conversions and setOpaque() off, so layers keep the format they were created in.
+     * Only meant for comparing both in tools/linborenderbenchmark.cpp, layers which exist already are not changed.
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+private:
+    LinboRenderConfig() {}
+
+    static int _framebufferDepth;
+    static bool _enabled;
+};
+
+#endif // LINBORENDERCONFIG_H
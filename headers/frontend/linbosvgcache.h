@@ -0,0 +1,110 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOSVGCACHE_H
+#define LINBOSVGCACHE_H
+
+#include <QObject>
+#include <QSvgRenderer>
+#include <QPixmap>
+#include <QPainter>
+#include <QCache>
+#include <QHash>
+#include <QColor>
+#include <QCoreApplication>
+#include <QImage>
+#include <QFile>
+#include <QTextStream>
+#include <QCryptographicHash>
+#include <QDir>
+
+#include "linborenderconfig.h"
+
+/**
+ * @brief The LinboSvgCache class rasterizes svg files once for the whole gui.
+ *
+ * Every svg document is parsed only once. Its rasterized pixmaps are kept per path, size, tint,
+ * aspect ratio mode and device pixel ratio in a cache which drops the least recently used pixmaps
+ * once it holds more than _maxCacheBytes.
+ *
+ * The bundled icons are also rasterized at common sizes during the build (see tools/linboiconatlas.cpp).
+ * Pixmaps of those sizes are copied from that atlas instead of being rendered. The atlas has one image
+ * per size, which is only decoded when an icon of that size is requested and dropped again by releaseAtlas().
+ *
+ * Svg files from outside the resources (os icons and themes from the server) can be persisted
+ * in a disk cache directory between boots. Its files are named after the hash of the source path,
+ * the hash of the file contents and the variant, so a changed file never hits an old entry.
+ * New entries are only written and stale ones only removed in closeDiskCache(). Pixmaps rendered while
+ * no disk cache is open are kept (up to _maxPendingWriteBytes) and written by the next one that is closed.
+ */
+class LinboSvgCache
+{
+public:
+    static QPixmap pixmap(
+        const QString& path,
+        QSize size,
+        const QColor& tint = QColor(),
+        Qt::AspectRatioMode aspectRatioMode = Qt::IgnoreAspectRatio,
+        qreal devicePixelRatio = 1
+    );
+
+    static void paint(
+        QPainter* painter,
+        const QRectF& rect,
+        const QString& path,
+        const QColor& tint = QColor(),
+        Qt::AspectRatioMode aspectRatioMode = Qt::IgnoreAspectRatio
+    );
+
+    static QSize defaultSize(const QString& path);
+    static bool isValid(const QString& path);
+
+    static void clear();
+    static void releaseAtlas();
+
+    static void openDiskCache(const QString& directory);
+    static void closeDiskCache(bool persist = true);
+    static bool hasPendingDiskCacheWrites();
+
+private:
+    LinboSvgCache() {}
+
+    static const int _maxCacheBytes = 24 * 1024 * 1024;
+    static const int _maxPendingWriteBytes = 4 * 1024 * 1024;
+
+    static QHash<QString, QSvgRenderer*> _renderers;
+    static QCache<QString, QPixmap> _pixmaps;
+
+    static bool _atlasLoaded;
+    static QHash<int, QImage> _atlases;
+    static QHash<QString, QRect> _atlasIndex;
+
+    static QString _diskCacheDirectory;
+    static QHash<QString, QString> _diskCacheSources;
+    static QHash<QString, QImage> _diskCacheWrites;
+    static qint64 _diskCacheWriteBytes;
+
+    static QSvgRenderer* _renderer(const QString& path);
+    static void _loadAtlas();
+    static const QImage& _atlasOfSize(int size);
+    static QPixmap _pixmapFromAtlas(const QString& path, QSize size);
+    static QString _diskCacheFileName(const QString& path, const QString& key);
+    static void _clearDiskCacheWrites();
+};
+
+#endif // LINBOSVGCACHE_H
@@ -0,0 +1,84 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#ifndef LINBOCLI_H
+#define LINBOCLI_H
+
+#include <QObject>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMetaEnum>
+
+#include "linbologarchive.h"
+#include "linbocachemount.h"
+#include "linbologger.h"
+#include "linbostructuredlog.h"
+#include "linbostartjitter.h"
+#include "linbobackend.h"
+
+/**
+ * @brief The LinboCli class implements the command line modes of linbo_gui, which don't need a display.
+ */
+class LinboCli : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LinboCli(QObject *parent = nullptr);
+
+    static bool isCliInvocation(int argc, char* argv[]);
+    int exec(const QStringList& arguments);
+
+private:
+    QTextStream _out;
+    QTextStream _err;
+
+    static inline const QStringList _modeOptions = {
+        "--log-archive-list",
+        "--log-archive-read",
+        "--log-export",
+        "--log-benchmark",
+        "--autostart-simulation",
+        "--headless"
+    };
+
+    int _listLogArchive(const QCommandLineParser& parser);
+    int _readLogArchive(const QCommandLineParser& parser);
+    int _exportStructuredLog(const QCommandLineParser& parser);
+    int _benchmarkLogger(const QCommandLineParser& parser);
+    int _simulateAutostart(const QCommandLineParser& parser);
+
+    int _runHeadless(const QCommandLineParser& parser);
+    bool _startHeadlessAction(LinboBackend* backend, QString action, LinboPostProcessActions::Flags postProcessActions, QString password);
+    bool _startHeadlessJobs(LinboBackend* backend, QString jobs, bool pipelined, LinboPostProcessActions::Flags postProcessActions, QString password);
+    static LinboJob* _parseJob(LinboBackend* backend, QString job);
+    static bool _parsePostProcessActions(QString actions, LinboPostProcessActions::Flags* postProcessActions);
+    static LinboOs* _findOs(LinboBackend* backend, QString name);
+
+    static QList<double> _simulateTransfers(QList<double> startSeconds, double serverBandwidth, double clientBandwidth, double transferSize, int* peakConcurrency);
+
+    static QByteArray _structuredLogTypeName(qint8 type);
+    static void _appendJsonString(QByteArray& output, const QString& string);
+
+    bool _parseTime(const QCommandLineParser& parser, QString option, QDateTime* time);
+    QString _logArchiveDirectory(const QCommandLineParser& parser);
+};
+
+#endif // LINBOCLI_H
@@ -29,10 +29,17 @@
 #include <QScreen>
 #include <QMainWindow>
 #include <QTranslator>
+#include <QLabel>
+#include <QKeyEvent>
+#include <QTimer>
 
 #include "linbomainpage.h"
 #include "linbobackend.h"
 #include "linboguitheme.h"
+#include "linboanimationclock.h"
+#include "linboidlegovernor.h"
+#include "linbosvgcache.h"
+#include "linbocachemount.h"
 
 class LinboGui : public QMainWindow
 {
@@ -42,10 +49,31 @@ public:
 
     //void done(int r) override;
 
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
 private:
     LinboBackend* _backend;
     LinboGuiTheme* _theme;
+    LinboAnimationClock* _animationClock;
+    LinboIdleGovernor* _idleGovernor;
     LinboMainPage* _startPage;
+    QLabel* _minimalProgressLabel;
+    QString _rasterCacheMountPoint;
+
+    bool _canUseHeadlessAutostart();
+    void _showMinimalProgress();
+    void _buildFullUi();
+    void _loadFonts();
+    void _installTranslator();
+    void _openRasterCache();
+    bool _canUseRasterCache();
+
+private slots:
+    void _closeRasterCache();
+    void _writeRasterCache();
+    void _handleLinboStateChangedInHeadlessAutostart(LinboBackend::LinboState state);
+    void _handleLatestLogChangedInHeadlessAutostart(const LinboLogger::LinboLog& latestLog);
 
 };
 
@@ -224,6 +224,11 @@
       <source>update</source>
       <translation>mettre à jour</translation>
     </message>
+    <message id="dialog_updateCache_button_retryFailed">
+      <location filename="../../../sources/frontend/dialogs/linboupdatecachedialog.cpp" line="77"/>
+      <source>retry failed</source>
+      <translation>réessayer les échecs</translation>
+    </message>
     <message id="client_info_mac">
       <location filename="../../../sources/frontend/linboclientinfo.cpp" line="44"/>
       <location filename="../../../sources/frontend/linboosselectionrow.cpp" line="65"/>
@@ -310,6 +315,16 @@
       <source>Logging out automatically</source>
       <translation>Déconnexion automatique</translation>
     </message>
+    <message id="main_autostart_admissionDelay">
+      <location filename="../../../sources/frontend/linbomainactions.cpp" line="412"/>
+      <source>(waiting %1s longer to spread the server load)</source>
+      <translation>(encore %1s d'attente pour répartir la charge du serveur)</translation>
+    </message>
+    <message id="main_updateCache_admissionDelay">
+      <location filename="../../../sources/frontend/linbomainactions.cpp" line="416"/>
+      <source>Updating the cache in %1s to spread the server load</source>
+      <translation>Mise à jour du cache dans %1s pour répartir la charge du serveur</translation>
+    </message>
     <message id="settings">
       <location filename="../../../sources/frontend/linbomainpage.cpp" line="116"/>
       <source>Settings</source>
@@ -370,10 +385,70 @@
       <source>Reinstall %1</source>
       <translation>Réinstaller %1</translation>
     </message>
+    <message id="main_imageFreshness_fresh">
+      <location filename="../../../sources/frontend/linboosselectbutton.cpp" line="233"/>
+      <source>The cached image is up to date</source>
+      <translation>L'image dans le cache est à jour</translation>
+    </message>
+    <message id="main_imageFreshness_stale">
+      <location filename="../../../sources/frontend/linboosselectbutton.cpp" line="237"/>
+      <source>The server has a newer image, the next sync will download it</source>
+      <translation>Le serveur a une image plus récente, la prochaine synchronisation la téléchargera</translation>
+    </message>
+    <message id="main_imageFreshness_missing">
+      <location filename="../../../sources/frontend/linboosselectbutton.cpp" line="241"/>
+      <source>The image is not in the cache yet</source>
+      <translation>L'image n'est pas encore dans le cache</translation>
+    </message>
     <message id="osSelection_noOperatingSystems">
       <location filename="../../../sources/frontend/linboosselectionrow.cpp" line="52"/>
       <source>No Operating system configured in start.conf</source>
       <translation>Aucun système d&apos;exploitation configuré dans start.conf</translation>
     </message>
+    <message id="dialog_logViewer_title">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="27"/>
+      <source>Logs</source>
+      <translation>Journaux</translation>
+    </message>
+    <message id="dialog_logViewer_search">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="39"/>
+      <source>Search</source>
+      <translation>Rechercher</translation>
+    </message>
+    <message id="dialog_logViewer_types_all">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="45"/>
+      <source>All messages</source>
+      <translation>Tous les messages</translation>
+    </message>
+    <message id="dialog_logViewer_types_errors">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="47"/>
+      <source>Errors only</source>
+      <translation>Erreurs uniquement</translation>
+    </message>
+    <message id="dialog_logViewer_types_gui">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="49"/>
+      <source>GUI messages</source>
+      <translation>Messages de l'interface</translation>
+    </message>
+    <message id="dialog_logViewer_types_output">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="54"/>
+      <source>Command output</source>
+      <translation>Sortie des commandes</translation>
+    </message>
+    <message id="dialog_logViewer_button_close">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="111"/>
+      <source>close</source>
+      <translation>fermer</translation>
+    </message>
+    <message id="dialog_logViewer_chapters_all">
+      <location filename="../../../sources/frontend/dialogs/linbologviewerdialog.cpp" line="156"/>
+      <source>All chapters</source>
+      <translation>Toutes les sections</translation>
+    </message>
+    <message id="main_root_button_showLogs">
+      <location filename="../../../sources/frontend/components/linboadminsidebar.cpp" line="273"/>
+      <source>Show logs</source>
+      <translation>Afficher les journaux</translation>
+    </message>
   </context>
 </TS>
@@ -0,0 +1,60 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linboactivitymonitor.h"
+
+LinboActivityMonitor::LinboActivityMonitor(QObject* parent) : QObject(parent)
+{
+    this->_paintEvents = 0;
+    this->_wakeups = 0;
+    this->_elapsedTimer.start();
+
+    if(QCoreApplication::instance() != nullptr)
+        QCoreApplication::instance()->installEventFilter(this);
+
+    if(QAbstractEventDispatcher::instance() != nullptr)
+        connect(QAbstractEventDispatcher::instance(), &QAbstractEventDispatcher::awake, this, [=] {
+            this->_wakeups++;
+        });
+}
+
+LinboActivityMonitor::Sample LinboActivityMonitor::sample() {
+    return Sample {this->_elapsedTimer.elapsed(), this->_paintEvents, this->_wakeups};
+}
+
+double LinboActivityMonitor::paintEventsPerSecond(const Sample& from, const Sample& to) {
+    return _perSecond(to.paintEvents - from.paintEvents, to.milliseconds - from.milliseconds);
+}
+
+double LinboActivityMonitor::wakeupsPerSecond(const Sample& from, const Sample& to) {
+    return _perSecond(to.wakeups - from.wakeups, to.milliseconds - from.milliseconds);
+}
+
+bool LinboActivityMonitor::eventFilter(QObject* watched, QEvent* event) {
+    if(event->type() == QEvent::Paint)
+        this->_paintEvents++;
+
+    return QObject::eventFilter(watched, event);
+}
+
+double LinboActivityMonitor::_perSecond(qint64 count, qint64 milliseconds) {
+    if(milliseconds <= 0)
+        return 0;
+
+    return double(count) * 1000 / double(milliseconds);
+}
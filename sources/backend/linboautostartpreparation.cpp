@@ -0,0 +1,127 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linboautostartpreparation.h"
+#include "linbocachemount.h"
+
+LinboAutostartPreparation::LinboAutostartPreparation(QObject* parent) : QThread(parent)
+{
+    this->_releaseRequested = false;
+    this->_keepCacheMounted = false;
+    this->_abortRequested = false;
+    this->_cacheMounted = false;
+    this->_imageCheck = ImageNotChecked;
+
+    connect(this, &QThread::finished, this, &LinboAutostartPreparation::_release);
+}
+
+LinboAutostartPreparation::~LinboAutostartPreparation() {
+    this->_abortRequested = true;
+    this->wait();
+}
+
+bool LinboAutostartPreparation::_prepare(QString cachePath, QStringList partitions, QString imageName) {
+    if(this->isRunning())
+        return false;
+
+    this->_cachePath = cachePath;
+    this->_partitions = partitions;
+    this->_imageName = imageName;
+    this->_mountPoint = "";
+    this->_releaseRequested = false;
+    this->_keepCacheMounted = false;
+    this->_abortRequested = false;
+    this->_cacheMounted = false;
+    this->_imageCheck = ImageNotChecked;
+
+    // must never compete with the GUI for the cpu
+    this->start(QThread::LowestPriority);
+    return true;
+}
+
+void LinboAutostartPreparation::_abort(bool keepCacheMounted) {
+    // never waits, a mount or read in progress would block the gui
+    this->_abortRequested = true;
+    this->_keepCacheMounted = keepCacheMounted;
+    this->_releaseRequested = true;
+
+    if(!this->isRunning())
+        this->_release();
+}
+
+void LinboAutostartPreparation::_release() {
+    // a preparation that finished before the countdown ended keeps the cache until it is aborted
+    if(!this->_releaseRequested)
+        return;
+
+    // finished() is emitted right before the thread ends
+    this->wait();
+    this->_releaseRequested = false;
+
+    // a cancelled autostart leaves the cache like it found it, a started one hands it over to linbo_cmd
+    if(!this->_mountPoint.isEmpty()) {
+        LinboCacheMount::release(this->_cachePath, this->_keepCacheMounted);
+        this->_mountPoint = "";
+    }
+    if(!this->_keepCacheMounted)
+        this->_cacheMounted = false;
+}
+
+void LinboAutostartPreparation::run() {
+    this->_mountPoint = LinboCacheMount::acquire(this->_cachePath);
+    if(this->_mountPoint.isEmpty() || this->_abortRequested)
+        return;
+    this->_cacheMounted = true;
+
+    for(const QString& partition : this->_partitions) {
+        if(this->_abortRequested)
+            return;
+        this->_preReadPartition(partition);
+    }
+
+    if(!this->_imageName.isEmpty() && !this->_abortRequested)
+        this->_imageCheck = this->_verifyImage(LinboCacheMount::imagePath(this->_mountPoint, this->_imageName));
+}
+
+void LinboAutostartPreparation::_preReadPartition(const QString& partition) {
+    QFile device(partition);
+    if(device.open(QFile::ReadOnly))
+        device.read(_metadataSize);
+}
+
+LinboAutostartPreparation::ImageCheck LinboAutostartPreparation::_verifyImage(const QString& imagePath) {
+    QFile checksumFile(imagePath + ".md5");
+    if(!checksumFile.open(QFile::ReadOnly))
+        return ImageWithoutChecksum;
+
+    // "<md5>  <file>" or just "<md5>"
+    QByteArray expectedChecksum = checksumFile.readAll().simplified().split(' ').first().toLower();
+
+    QFile image(imagePath);
+    if(expectedChecksum.isEmpty() || !image.open(QFile::ReadOnly))
+        return ImageWithoutChecksum;
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    while(!image.atEnd()) {
+        if(this->_abortRequested)
+            return ImageNotChecked;
+        hash.addData(image.read(_chunkSize));
+    }
+
+    return hash.result().toHex() == expectedChecksum ? ImageOk : ImageCorrupt;
+}
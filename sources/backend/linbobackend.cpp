@@ -22,7 +22,7 @@
 
 #include "linbobackend.h"
 
-LinboBackend::LinboBackend(QObject *parent) : QObject(parent)
+LinboBackend::LinboBackend(QObject *parent, bool executeAutomaticTasks) : QObject(parent)
 {
     this->_logger = nullptr;
     this->_rootPassword = "";
@@ -30,17 +30,64 @@ LinboBackend::LinboBackend(QObject *parent) : QObject(parent)
     this->_state = Initializing;
     this->_postProcessActions = LinboPostProcessActions::NoAction;
     this->_osOfCurrentAction = nullptr;
+    this->_admissionDelay = 0;
+    this->_admissionDelayApplied = false;
 
     this->_logger = new LinboLogger("/tmp/linbo.log", this);
 
     this->_linboCmd = new LinboCmd(this->_logger, this);
     connect(this->_linboCmd, &LinboCmd::commandFinished, this, &LinboBackend::_handleCommandFinished);
+    connect(this->_linboCmd, &LinboCmd::backgroundCommandFinished, this, &LinboBackend::_handleBackgroundCommandFinished);
+
+    this->_jobQueue = new LinboJobQueue(this, this->_logger);
+
+    // the cache updater reports like a single command, so the job queue and post process actions work unchanged
+    this->_cacheUpdater = new LinboCacheUpdater(this->_linboCmd, this->_logger, this);
+    connect(this->_cacheUpdater, &LinboCacheUpdater::finished, this, [=](bool successful) {
+        this->_handleCommandFinished(successful ? 0 : 1, QProcess::NormalExit);
+    });
 
     this->_configReader = new LinboConfigReader(this);
     this->_config = this->_configReader->readConfig();
 
+    if(this->_config->logArchiveEnabled()) {
+        this->_logger->_enableArchive(new LinboLogArchive(
+            this->_config->cachePath(),
+            (qint64)this->_config->logArchiveMaxSize() * 1024 * 1024,
+            this->_config->logArchiveMaxAge()
+        ));
+    }
+
+    this->_logger->_configureSink(LinboLogger::ConsoleSink, this->_config->logConsole());
+    this->_logger->_configureSink(LinboLogger::FileSink, this->_config->logFile());
+    this->_logger->_configureSink(LinboLogger::HistorySink, this->_config->logHistory());
+    this->_logger->_configureSink(LinboLogger::StructuredSink, this->_config->logStructured());
+
     this->_initTimers();
 
+    this->_autostartPreparation = new LinboAutostartPreparation(this);
+    // the preparation keeps the cache mounted until the countdown ends
+    connect(this->_autostartPreparation, &QThread::finished, this, [=] {
+        if(this->_autostartPreparation->cacheMounted())
+            emit this->cacheMounted();
+    });
+
+    // starts checking once the state changes to Idle
+    this->_freshnessChecker = new LinboFreshnessChecker(this, this->_logger, this->_config);
+    connect(this->_freshnessChecker, &LinboFreshnessChecker::cacheMounted, this, &LinboBackend::cacheMounted);
+
+    this->_controlServer = new LinboControlServer(this, this->_logger);
+
+    // without automatic tasks (eg. the headless cli), the caller is in control
+    if(!executeAutomaticTasks) {
+        this->_setState(Idle);
+        return;
+    }
+
+    // only the gui instance owns the control socket, the headless cli must not take it away
+    if(!this->_config->controlSocket().isEmpty())
+        this->_controlServer->_listen(this->_config->controlSocket());
+
     if(this->_config->guiDisabled()) {
         this->_setState(Disabled);
         this->_logger->_log("Linbo GUI is disabled", LinboLogger::LinboGuiInfo);
@@ -59,17 +106,21 @@ LinboBackend::LinboBackend(QObject *parent) : QObject(parent)
 // --------------------
 
 LinboOs* LinboBackend::osOfCurrentAction() {
-    QList<LinboState> osBaseStates = {Autostarting, Starting, Syncing, Reinstalling, CreatingImage, UploadingImage, StartActionError, RootActionError, RootActionSuccess};
+    QList<LinboState> osBaseStates = {Autostarting, Starting, Syncing, Reinstalling, CreatingImage, UploadingImage, SyncingOs, StartActionError, RootActionError, RootActionSuccess};
     if(!osBaseStates.contains(this->state()))
         return nullptr;
     return this->_osOfCurrentAction;
 }
 
 void LinboBackend::shutdown() {
+    this->_logger->info("Shutting down");
+    this->_logger->flush();
     QProcess::execute("busybox", {"poweroff"});
 }
 
 void LinboBackend::reboot() {
+    this->_logger->info("Rebooting");
+    this->_logger->flush();
     QProcess::execute("busybox", {"reboot"});
 }
 
@@ -82,7 +133,12 @@ bool LinboBackend::startOs(LinboOs* os) {
     this->_osOfCurrentAction = os;
     this->_setState(Starting);
 
-    return this->_linboCmd->startOs(os, this->_config->cachePath());
+    // linbo_cmd will boot into the os, make sure the log made it to the disk
+    this->_logger->flush();
+
+    return this->_runAfterAutostartPreparation([=] {
+        return this->_linboCmd->startOs(os, this->_config->cachePath());
+    });
 }
 
 bool LinboBackend::syncOs(LinboOs* os) {
@@ -94,7 +150,9 @@ bool LinboBackend::syncOs(LinboOs* os) {
     this->_osOfCurrentAction = os;
     this->_setState(Syncing);
 
-    return this->_linboCmd->syncOs(os, this->_config->serverIpAddress(), this->_config->cachePath());
+    return this->_runAfterAutostartPreparation([=] {
+        return this->_linboCmd->syncOs(os, this->_config->serverIpAddress(), this->_config->cachePath());
+    });
 }
 
 bool LinboBackend::reinstallOs(LinboOs* os) {
@@ -106,7 +164,9 @@ bool LinboBackend::reinstallOs(LinboOs* os) {
     this->_osOfCurrentAction = os;
     this->_setState(Reinstalling);
 
-    return this->_linboCmd->reinstallOs(os, this->_config->serverIpAddress(), this->_config->cachePath());
+    return this->_runAfterAutostartPreparation([=] {
+        return this->_linboCmd->reinstallOs(os, this->_config->serverIpAddress(), this->_config->cachePath());
+    });
 }
 
 bool LinboBackend::login(QString password) {
@@ -136,7 +196,8 @@ void LinboBackend::logout() {
 void LinboBackend::restartRootTimeout() {
     if(this->_state == Root && this->_config->rootTimeout() > 0) {
         this->_timeoutTimer->start((this->_config->rootTimeout() * 1000) / 2);
-        this->_timeoutRemainingTimeRefreshTimer->start();
+        // the countdown is only shown in RootTimeout, there is nothing to refresh until then
+        this->_timeoutRemainingTimeRefreshTimer->stop();
     }
 }
 
@@ -149,7 +210,7 @@ bool LinboBackend::createDiffImageOfOs(LinboOs* os, QString description, LinboPo
 }
 
 bool LinboBackend::_createImageOfOs(LinboOs* os, QString name, QString description, LinboPostProcessActions::Flags postProcessActions) {
-    if(this->_state != Root)
+    if(!this->_canStartRootAction())
         return false;
 
     this->_postProcessActions = postProcessActions;
@@ -193,7 +254,7 @@ bool LinboBackend::uploadImage(LinboImage* image, LinboPostProcessActions::Flags
 }
 
 bool LinboBackend::_uploadImage(LinboImage* image, LinboPostProcessActions::Flags postProcessActions) {
-    if(this->_state != Root && this->_state != CreatingImage)
+    if(!this->_canStartRootAction() && this->_state != CreatingImage)
         return false;
 
     if(image == nullptr)
@@ -207,12 +268,33 @@ bool LinboBackend::_uploadImage(LinboImage* image, LinboPostProcessActions::Flag
     return this->_linboCmd->uploadImage(image, this->_rootPassword, this->_config->serverIpAddress(), this->_config->cachePath());
 }
 
+bool LinboBackend::_uploadImageInBackground(LinboImage* image) {
+    if(image == nullptr || !this->_jobQueue->isRunning())
+        return false;
+
+    // No chapter and no state change, those belong to the action in the foreground
+    this->_logger->_log("Uploading image " + image->name() + " in the background", LinboLogger::LinboGuiInfo);
+    return this->_linboCmd->uploadImage(image, this->_rootPassword, this->_config->serverIpAddress(), this->_config->cachePath(), true);
+}
+
+bool LinboBackend::_syncOsWithoutStart(LinboOs* os) {
+    if(os == nullptr || os->baseImage() == nullptr || !this->_canStartRootAction())
+        return false;
+
+    this->_postProcessActions = LinboPostProcessActions::NoAction;
+    this->_logger->_log("Syncing " + os->name(), LinboLogger::LinboLogChapterBeginning);
+    this->_osOfCurrentAction = os;
+    this->_setState(SyncingOs);
+
+    return this->_linboCmd->syncOsWithoutStart(os, this->_config->serverIpAddress(), this->_config->cachePath());
+}
+
 bool LinboBackend::partitionDrive() {
     return this->_partitionDrive(true, LinboPostProcessActions::NoAction);
 }
 
 bool LinboBackend::_partitionDrive(bool format, LinboPostProcessActions::Flags postProcessActions) {
-    if(this->_state != Root && this->_state != Initializing)
+    if(!this->_canStartRootAction() && this->_state != Initializing)
         return false;
 
     this->_osOfCurrentAction = nullptr;
@@ -224,9 +306,23 @@ bool LinboBackend::_partitionDrive(bool format, LinboPostProcessActions::Flags p
 }
 
 bool LinboBackend::updateCache(LinboConfig::DownloadMethod downloadMethod, bool format, LinboPostProcessActions::Flags postProcessActions) {
-    if(this->_state != Root && this->_state != Initializing && this->_state != UpdatingCache)
+    if(!this->_canStartRootAction() && this->_state != Initializing && this->_state != UpdatingCache)
+        return false;
+
+    return this->_updateCache(downloadMethod, format, postProcessActions);
+}
+
+bool LinboBackend::_updateCacheForControlClient(LinboConfig::DownloadMethod downloadMethod, bool format) {
+    if(this->_state == Root)
+        return this->_updateCache(downloadMethod, format, LinboPostProcessActions::NoAction);
+    else if(this->_state != Idle)
         return false;
 
+    // the gui itself is not logged in, the logout takes it back to Idle without ever showing the root pages
+    return this->_updateCache(downloadMethod, format, LinboPostProcessActions::Logout);
+}
+
+bool LinboBackend::_updateCache(LinboConfig::DownloadMethod downloadMethod, bool format, LinboPostProcessActions::Flags postProcessActions) {
     this->_osOfCurrentAction = nullptr;
     this->_postProcessActions = postProcessActions;
     this->_logger->_log("Updating cache", LinboLogger::LinboLogChapterBeginning);
@@ -235,15 +331,36 @@ bool LinboBackend::updateCache(LinboConfig::DownloadMethod downloadMethod, bool
     if(downloadMethod < LinboConfig::Rsync || downloadMethod > LinboConfig::Torrent)
         downloadMethod = this->_config->downloadMethod();
 
-    return this->_linboCmd->updateCache(
+    // every base image is downloaded by its own process
+    QList<LinboImage*> images;
+    for(LinboOs* os : this->_config->operatingSystems()) {
+        if(os->baseImage() != nullptr && !images.contains(os->baseImage()))
+            images.append(os->baseImage());
+    }
+
+    return this->_cacheUpdater->_start(
                downloadMethod,
                format,
-               this->_config->operatingSystems(),
+               images,
                this->_config->serverIpAddress(),
-               this->_config->cachePath()
+               this->_config->cachePath(),
+               this->_config->initCacheConcurrency(),
+               this->_config->initCacheRetries()
            );
 }
 
+bool LinboBackend::retryCacheUpdate() {
+    if(!this->_canStartRootAction() || !this->_cacheUpdater->hasFailedImages())
+        return false;
+
+    this->_osOfCurrentAction = nullptr;
+    this->_postProcessActions = LinboPostProcessActions::NoAction;
+    this->_logger->_log("Retrying failed images of the cache update", LinboLogger::LinboLogChapterBeginning);
+    this->_setState(UpdatingCache);
+
+    return this->_cacheUpdater->_retryFailed();
+}
+
 bool LinboBackend::updateLinbo() {
     if(this->_state != Root)
         return false;
@@ -296,8 +413,18 @@ bool LinboBackend::cancelCurrentAction() {
     case UpdatingCache:
     case CreatingImage:
     case UploadingImage:
+    case SyncingOs:
         this->_logger->_log("Cancelling current action: " + QString::number(this->_state), LinboLogger::LinboGuiInfo);
+        // the remaining jobs must not be started when the killed process finishes
+        this->_jobQueue->abort();
         this->_linboCmd->killAsyncProcess();
+        this->_linboCmd->killBackgroundProcess();
+        this->_cacheUpdater->_kill();
+        if(this->_admissionTimer->isActive()) {
+            this->_admissionTimer->stop();
+            this->_timeoutRemainingTimeRefreshTimer->stop();
+        }
+        this->_admissionDelay = 0;
         if(!this->_postProcessActions.testFlag(LinboPostProcessActions::Logout))
             this->_setState(Root);
         else
@@ -338,6 +465,26 @@ LinboConfig* LinboBackend::config() {
     return this->_config;
 }
 
+LinboJobQueue* LinboBackend::jobQueue() {
+    return this->_jobQueue;
+}
+
+LinboCacheUpdater* LinboBackend::cacheUpdater() {
+    return this->_cacheUpdater;
+}
+
+int LinboBackend::remainingAdmissionDelay() {
+    // the automatic cache update waits on its own timer
+    if(this->_admissionTimer->isActive())
+        return this->_admissionTimer->remainingTime();
+
+    // the autostart countdown is extended by the delay, which passes first
+    if(this->_state == Autostarting && this->_admissionDelay > 0 && this->_osOfCurrentAction != nullptr)
+        return qMax(0, this->_timeoutRemainingMilliseconds() - this->_osOfCurrentAction->autostartTimeout() * 1000);
+
+    return 0;
+}
+
 QString LinboBackend::loadEnvironmentValue(QString key) {
     return this->_linboCmd->getOutput(key).replace("\n", "");
 }
@@ -373,26 +520,129 @@ bool LinboBackend::_executeAutoPartition() {
 bool LinboBackend::_executeAutoInitCache() {
     if(this->_config->autoInitCache()) {
         this->_setState(UpdatingCache);
+
+        int admissionDelay = this->_takeAdmissionDelay();
+        if(admissionDelay > 0) {
+            // so cancelling while waiting logs out like cancelling the update itself
+            this->_postProcessActions = LinboPostProcessActions::ExecuteAutostart | LinboPostProcessActions::Logout;
+            this->_logger->_log("Waiting " + QString::number(admissionDelay / 1000) + "s before updating the cache to spread the server load", LinboLogger::LinboGuiInfo);
+            this->_admissionTimer->start(admissionDelay);
+            // shown as a countdown
+            this->_timeoutRemainingTimeRefreshTimer->start();
+            return true;
+        }
+
         return this->updateCache(this->_config->downloadMethod(), false, LinboPostProcessActions::ExecuteAutostart | LinboPostProcessActions::Logout);
     }
     return false;
 }
 
+void LinboBackend::_handleAdmissionTimerTimeout() {
+    this->_admissionDelay = 0;
+    // the countdown is over, the update itself has no countdown
+    this->_timeoutRemainingTimeRefreshTimer->stop();
+    emit this->timeoutProgressChanged(1.0, 0);
+
+    if(this->_state == UpdatingCache)
+        this->updateCache(this->_config->downloadMethod(), false, LinboPostProcessActions::ExecuteAutostart | LinboPostProcessActions::Logout);
+}
+
 bool LinboBackend::_executeAutostart() {
     LinboOs* osForAutostart = this->_getOsForAutostart();
     if(osForAutostart == nullptr) {
         return false;
     }
 
+    // Starting only needs the cache, syncing and reinstalling download from the server
+    this->_admissionDelay = 0;
+    if(osForAutostart->defaultAction() != LinboOs::StartOs)
+        this->_takeAdmissionDelay();
+
     this->_osOfCurrentAction = osForAutostart;
     this->_setState(Autostarting);
     this->_logger->_log("Beginning autostart timeout for " + osForAutostart->name(), LinboLogger::LinboGuiInfo);
-    this->_timeoutTimer->setInterval(osForAutostart->autostartTimeout() * 1000);
+    if(this->_admissionDelay > 0)
+        this->_logger->_log("Autostart is delayed by " + QString::number(this->_admissionDelay / 1000) + "s to spread the server load", LinboLogger::LinboGuiInfo);
+    this->_timeoutTimer->setInterval(osForAutostart->autostartTimeout() * 1000 + this->_admissionDelay);
     this->_timeoutTimer->start();
     this->_timeoutRemainingTimeRefreshTimer->start();
+    this->_startAutostartPreparation(osForAutostart);
+    return true;
+}
+
+void LinboBackend::_startAutostartPreparation(LinboOs* os) {
+    QStringList partitions;
+    for(const QString& partition : {os->bootPartition(), os->rootPartition()})
+        if(!partition.isEmpty() && !partitions.contains(partition))
+            partitions.append(partition);
+
+    // the image is only read by sync and reinstall
+    QString imageName;
+    if(os->defaultAction() != LinboOs::StartOs && os->baseImage() != nullptr)
+        imageName = os->baseImage()->name();
+
+    this->_autostartPreparation->_prepare(this->_config->cachePath(), partitions, imageName);
+}
+
+void LinboBackend::_finishAutostartPreparation(bool keepCacheMounted) {
+    this->_autostartPreparation->_abort(keepCacheMounted);
+    if(!keepCacheMounted)
+        return;
+
+    this->_runAfterAutostartPreparation([=] {
+        this->_logAutostartPreparationResult();
+        return true;
+    });
+}
+
+void LinboBackend::_logAutostartPreparationResult() {
+    QString result = this->_autostartPreparation->cacheMounted() ? "cache mounted" : "cache not mounted";
+    switch (this->_autostartPreparation->imageCheck()) {
+    case LinboAutostartPreparation::ImageOk:
+        result += ", image verified";
+        break;
+    case LinboAutostartPreparation::ImageWithoutChecksum:
+        result += ", image has no checksum";
+        break;
+    case LinboAutostartPreparation::ImageCorrupt:
+        result += ", image does not match its checksum";
+        break;
+    default:
+        break;
+    }
+
+    this->_logger->_log(
+        "Autostart preparation: " + result,
+        this->_autostartPreparation->imageCheck() == LinboAutostartPreparation::ImageCorrupt ? LinboLogger::LinboGuiError : LinboLogger::LinboGuiInfo
+    );
+}
+
+bool LinboBackend::_runAfterAutostartPreparation(std::function<bool()> action) {
+    if(!this->_autostartPreparation->isRunning())
+        return action();
+
+    // linbo_cmd must not be started while the aborted preparation still uses the cache
+    connect(this->_autostartPreparation, &QThread::finished, this, [=] {
+        if(!action())
+            this->_logger->_log("Could not execute the action after the autostart preparation", LinboLogger::LinboGuiError);
+    }, Qt::SingleShotConnection);
     return true;
 }
 
+int LinboBackend::_takeAdmissionDelay() {
+    // only the first network heavy automatic action of a boot is delayed
+    if(this->_admissionDelayApplied)
+        return 0;
+
+    this->_admissionDelayApplied = true;
+    this->_admissionDelay = LinboStartJitter::delayMilliseconds(
+                                this->_config->macAddress(),
+                                this->_config->autostartJitter(),
+                                this->_config->autostartWindow()
+                            );
+    return this->_admissionDelay;
+}
+
 LinboOs* LinboBackend::_getOsForAutostart() {
     LinboOs* osForAutostart = nullptr;
     for(LinboOs* os : this->_config->operatingSystems()) {
@@ -421,13 +671,18 @@ void LinboBackend::_logout(bool force) {
 void LinboBackend::_initTimers() {
     this->_timeoutRemainingTimeRefreshTimer = new QTimer(this);
     this->_timeoutRemainingTimeRefreshTimer->setSingleShot(false);
-    this->_timeoutRemainingTimeRefreshTimer->setInterval(10);
+    // the gui animates the progress in between, this is only for the remaining seconds
+    this->_timeoutRemainingTimeRefreshTimer->setInterval(250);
     connect(this->_timeoutRemainingTimeRefreshTimer, &QTimer::timeout, this, &LinboBackend::_handleTimeoutRemaningTimeRefreshTimerTimeout);
 
     this->_timeoutTimer = new QTimer(this);
     this->_timeoutTimer->setSingleShot(true);
     connect(this->_timeoutTimer, &QTimer::timeout, this->_timeoutRemainingTimeRefreshTimer, &QTimer::stop);
     connect(this->_timeoutTimer, &QTimer::timeout, this, &LinboBackend::_handleTimeoutTimerTimeout);
+
+    this->_admissionTimer = new QTimer(this);
+    this->_admissionTimer->setSingleShot(true);
+    connect(this->_admissionTimer, &QTimer::timeout, this, &LinboBackend::_handleAdmissionTimerTimeout);
 }
 
 void LinboBackend::_handleTimeoutRemaningTimeRefreshTimerTimeout() {
@@ -438,19 +693,28 @@ void LinboBackend::_handleTimeoutRemaningTimeRefreshTimerTimeout() {
 }
 
 double LinboBackend::_timeoutProgress() {
-    if(!this->_timeoutTimer->isActive())
+    QTimer* countdownTimer = this->_countdownTimer();
+    if(!countdownTimer->isActive())
         return 1.0;
 
-    double remaningTime = this->_timeoutTimer->remainingTime();
-    double totalTime = this->_timeoutTimer->interval();
+    double remaningTime = countdownTimer->remainingTime();
+    double totalTime = countdownTimer->interval();
     return 1 - remaningTime / totalTime;
 }
 
 int LinboBackend::_timeoutRemainingMilliseconds() {
-    if(!this->_timeoutTimer->isActive())
+    QTimer* countdownTimer = this->_countdownTimer();
+    if(!countdownTimer->isActive())
         return 0;
 
-    return this->_timeoutTimer->remainingTime();
+    return countdownTimer->remainingTime();
+}
+
+QTimer* LinboBackend::_countdownTimer() {
+    // the wait before the automatic cache update is counted down like a timeout
+    if(this->_admissionTimer->isActive())
+        return this->_admissionTimer;
+    return this->_timeoutTimer;
 }
 
 void LinboBackend::_handleTimeoutTimerTimeout() {
@@ -484,6 +748,7 @@ void LinboBackend::_handleRootTimerTimeout() {
         // timeout for the first time -> switch to timeout state
         this->restartRootTimeout();
         this->_setState(RootTimeout);
+        this->_timeoutRemainingTimeRefreshTimer->start();
     }
     else if(this->_state == RootTimeout) {
         // timeout for the second time -> logout
@@ -496,18 +761,98 @@ void LinboBackend::_handleRootTimerTimeout() {
     }
 }
 
+// -- Job helpers --
+
+bool LinboBackend::_executeJob(LinboJob* job) {
+    switch (job->type()) {
+    case LinboJob::CreateBaseImageJob:
+    case LinboJob::CreateDiffImageJob:
+        if(job->os() == nullptr || job->os()->baseImage() == nullptr)
+            return false;
+        return this->_createImageOfOs(job->os(), job->imageName(), job->description());
+
+    case LinboJob::UploadImageJob: {
+        LinboImage* image = this->_imageOfJob(job);
+        if(job->runsInBackground())
+            return this->_uploadImageInBackground(image);
+        return this->_uploadImage(image, LinboPostProcessActions::NoAction);
+    }
+
+    case LinboJob::SyncOsJob:
+        return this->_syncOsWithoutStart(job->os());
+
+    case LinboJob::InitCacheJob:
+        return this->updateCache(job->downloadMethod(), job->format());
+
+    case LinboJob::PartitionDriveJob:
+        return this->_partitionDrive(job->format(), LinboPostProcessActions::NoAction);
+    }
+
+    return false;
+}
+
+LinboImage* LinboBackend::_imageOfJob(LinboJob* job) {
+    LinboImage* image = this->_config->getImageByName(job->imageName());
+    if(image != nullptr || job->imageName().isEmpty())
+        return image;
+
+    // eg. a diff image which was created by a previous job.
+    // It is added to the config like the images found in the cache, so the next upload finds it there
+    image = new LinboImage(job->imageName(), this);
+    image->_os = job->os();
+    image->_existsOnDisk = true;
+    this->_config->_images.insert(image->name(), image);
+    return image;
+}
+
+void LinboBackend::_showBackgroundJob(LinboJob* job) {
+    if(job == nullptr)
+        return;
+
+    this->_osOfCurrentAction = job->os();
+    this->_setState(UploadingImage);
+}
+
+void LinboBackend::_handleJobQueueFinished(bool successful) {
+    if(!successful) {
+        this->_postProcessActions = LinboPostProcessActions::NoAction;
+        this->_setState(RootActionError);
+        return;
+    }
+
+    this->_postProcessActions = this->_jobQueue->postProcessActions();
+    if(this->_noMorePostProcessActionsToExecute())
+        this->_setState(RootActionSuccess);
+    else
+        this->_executeNextPostProcessAction();
+}
+
 // -- Command helpers --
 
 void LinboBackend::_handleCommandFinished(int exitCode, QProcess::ExitStatus exitStatus) {
     Q_UNUSED(exitStatus)
-    if(exitCode == 0) {
+    if(exitCode == 0)
         this->_logger->chapterEnd("Command finished successfully.");
-        this->_handleCommandFinishedSuccess();
-    }
-    else {
+    else
         this->_logger->chapterEnd("Command finished with an error.");
+
+    if(this->_jobQueue->isRunning())
+        this->_jobQueue->_handleJobFinished(this->_jobQueue->currentJob(), exitCode == 0);
+    else if(exitCode == 0)
+        this->_handleCommandFinishedSuccess();
+    else
         this->_handleCommandFinishedError();
-    }
+}
+
+void LinboBackend::_handleBackgroundCommandFinished(int exitCode, QProcess::ExitStatus exitStatus) {
+    Q_UNUSED(exitStatus)
+    if(exitCode == 0)
+        this->_logger->_log("Background command finished successfully.", LinboLogger::LinboGuiInfo);
+    else
+        this->_logger->_log("Background command finished with an error.", LinboLogger::LinboGuiError);
+
+    if(this->_jobQueue->isRunning())
+        this->_jobQueue->_handleJobFinished(this->_jobQueue->backgroundJob(), exitCode == 0);
 }
 
 void LinboBackend::_handleCommandFinishedSuccess() {
@@ -622,11 +967,23 @@ LinboBackend::LinboState LinboBackend::state() {
     return this->_state;
 }
 
+bool LinboBackend::_canStartRootAction() {
+    // While the job queue is running, the next job starts in the state of the previous one
+    return this->_state == Root || (this->_jobQueue->isRunning() && this->_state > Root);
+}
+
 void LinboBackend::_setState(LinboState state) {
     if(this->_state == state)
         return;
 
+    // only tells the preparation to stop, linbo_cmd is started once it has (see _runAfterAutostartPreparation)
+    if(this->_state == Autostarting)
+        this->_finishAutostartPreparation(state == Starting || state == Syncing || state == Reinstalling);
+
     this->_state = state;
+    if(this->_logger != nullptr)
+        this->_logger->_setLinboState(state);
+
     emit this->stateChanged(this->_state);
 
     if(this->_logger != nullptr)
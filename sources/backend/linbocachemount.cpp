@@ -0,0 +1,133 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbocachemount.h"
+
+QMutex LinboCacheMount::_mutex;
+QHash<QString, LinboCacheMount::_Mount> LinboCacheMount::_mounts;
+
+QString LinboCacheMount::mountPointOf(const QString& device) {
+#ifdef TEST_ENV
+    Q_UNUSED(device)
+    return _defaultMountPoint;
+#else
+    if(device.isEmpty())
+        return "";
+
+    QFile mounts("/proc/mounts");
+    if(!mounts.open(QIODevice::ReadOnly))
+        return "";
+
+    // the device might be a symlink (eg. /dev/disk/by-label/cache)
+    QString canonicalDevice = QFileInfo(device).canonicalFilePath();
+    if(canonicalDevice.isEmpty())
+        canonicalDevice = device;
+
+    for(const QByteArray& line : mounts.readAll().split('\n')) {
+        QList<QByteArray> fields = line.split(' ');
+        if(fields.length() < 2)
+            continue;
+
+        QString mountedDevice = QString::fromUtf8(fields[0]);
+        if(mountedDevice == device || QFileInfo(mountedDevice).canonicalFilePath() == canonicalDevice)
+            return QString::fromUtf8(fields[1]).replace("\\040", " ");
+    }
+
+    return "";
+#endif
+}
+
+QString LinboCacheMount::acquire(const QString& device, bool mountIfNeeded) {
+    if(device.isEmpty())
+        return "";
+
+    // a caller that does not mount must not wait for a mount in progress in another thread
+    if(!mountIfNeeded && !_mutex.tryLock())
+        return "";
+    else if(mountIfNeeded)
+        _mutex.lock();
+
+    QString mountPoint = _acquire(device, mountIfNeeded);
+    _mutex.unlock();
+    return mountPoint;
+}
+
+QString LinboCacheMount::_acquire(const QString& device, bool mountIfNeeded) {
+    if(_mounts.contains(device)) {
+        _mounts[device].references++;
+        return _mounts[device].mountPoint;
+    }
+
+    _Mount mount {mountPointOf(device), 1, false};
+    if(mount.mountPoint.isEmpty() && mountIfNeeded) {
+        mount.mountPoint = _mount(device);
+        mount.mountedByUs = !mount.mountPoint.isEmpty();
+    }
+
+    if(mount.mountPoint.isEmpty())
+        return "";
+
+    _mounts.insert(device, mount);
+    return mount.mountPoint;
+}
+
+void LinboCacheMount::release(const QString& device, bool keepMounted) {
+    QMutexLocker locker(&_mutex);
+
+    if(!_mounts.contains(device))
+        return;
+
+    // whoever the cache is kept mounted for (linbo_cmd) is responsible for it from now on
+    if(keepMounted)
+        _mounts[device].mountedByUs = false;
+
+    if(--_mounts[device].references > 0)
+        return;
+
+    _Mount mount = _mounts.take(device);
+    if(mount.mountedByUs)
+        _unmount(mount.mountPoint);
+}
+
+QString LinboCacheMount::_mount(const QString& device) {
+    QDir().mkpath(_defaultMountPoint);
+    if(QProcess::execute("mount", {device, _defaultMountPoint}) != 0)
+        return "";
+
+    return _defaultMountPoint;
+}
+
+bool LinboCacheMount::_unmount(const QString& mountPoint) {
+#ifdef TEST_ENV
+    Q_UNUSED(mountPoint)
+    return true;
+#else
+    if(mountPoint.isEmpty())
+        return false;
+
+    return QProcess::execute("umount", {mountPoint}) == 0;
+#endif
+}
+
+QString LinboCacheMount::imagePath(const QString& mountPoint, const QString& imageName) {
+    // newer caches keep every image in a directory named after it
+    QString imageInDirectory = mountPoint + "/" + imageName.section(".", 0, 0) + "/" + imageName;
+    if(QFile::exists(imageInDirectory))
+        return imageInDirectory;
+    return mountPoint + "/" + imageName;
+}
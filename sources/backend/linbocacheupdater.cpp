@@ -0,0 +1,271 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbocacheupdater.h"
+#include "linbobackend.h"
+
+LinboCacheUpdater::LinboCacheUpdater(LinboCmd* linboCmd, LinboLogger* logger, LinboBackend* backend) : QObject(backend)
+{
+    this->_linboCmd = linboCmd;
+    this->_logger = logger;
+    this->_running = false;
+    this->_format = false;
+    this->_downloadMethod = LinboConfig::Rsync;
+    this->_concurrency = 1;
+    this->_maxAttempts = 1;
+}
+
+LinboImage* LinboCacheUpdater::image(int index) {
+    if(index < 0 || index >= this->_images.length())
+        return nullptr;
+    return this->_images[index].image;
+}
+
+QString LinboCacheUpdater::imageName(int index) {
+    LinboImage* image = this->image(index);
+    if(image == nullptr)
+        return "cache";
+    return image->name();
+}
+
+LinboCacheUpdater::ImageStatus LinboCacheUpdater::status(int index) {
+    if(index < 0 || index >= this->_images.length())
+        return Waiting;
+    return this->_images[index].status;
+}
+
+int LinboCacheUpdater::attempts(int index) {
+    if(index < 0 || index >= this->_images.length())
+        return 0;
+    return this->_images[index].attempts;
+}
+
+QString LinboCacheUpdater::latestOutput(int index) {
+    if(index < 0 || index >= this->_images.length())
+        return "";
+    return this->_images[index].latestOutput;
+}
+
+int LinboCacheUpdater::countWithStatus(ImageStatus status) {
+    int count = 0;
+    for(const ImageState& state : this->_images)
+        if(state.status == status)
+            count++;
+    return count;
+}
+
+QString LinboCacheUpdater::statusToString(ImageStatus status) {
+    switch (status) {
+    case Waiting:
+        return "waiting";
+    case Downloading:
+        return "downloading";
+    case Done:
+        return "done";
+    case Failed:
+        return "failed";
+    }
+    return "";
+}
+
+bool LinboCacheUpdater::_start(LinboConfig::DownloadMethod downloadMethod, bool format, QList<LinboImage*> images, QString serverIP, QString cachePath, int concurrency, int retries) {
+    // killed processes might still be running
+    if(this->_running || this->countWithStatus(Downloading) > 0)
+        return false;
+
+    this->_images.clear();
+    this->_downloadMethod = downloadMethod;
+    this->_format = format;
+    this->_serverIP = serverIP;
+    this->_cachePath = cachePath;
+    this->_concurrency = qMax(1, concurrency);
+    this->_maxAttempts = qMax(0, retries) + 1;
+
+    // Without any images, the cache itself still has to be initialized
+    if(images.isEmpty())
+        images.append(nullptr);
+
+    for(LinboImage* image : images)
+        this->_images.append({image, Waiting, 0, "", nullptr});
+
+    this->_running = true;
+    this->_startNextImages();
+    return true;
+}
+
+bool LinboCacheUpdater::_retryFailed() {
+    if(this->_running || !this->hasFailedImages())
+        return false;
+
+    // The cache was formatted already, only the failed images are downloaded again
+    this->_format = false;
+    for(int i = 0; i < this->_images.length(); i++) {
+        if(this->_images[i].status != Failed)
+            continue;
+        this->_images[i].attempts = 0;
+        this->_setStatus(i, Waiting);
+    }
+
+    this->_running = true;
+    this->_startNextImages();
+    return true;
+}
+
+void LinboCacheUpdater::_kill() {
+    // set before killing, so the finished handlers do not start the next images
+    this->_running = false;
+    for(ImageState& state : this->_images) {
+        if(state.process != nullptr)
+            state.process->kill();
+    }
+}
+
+void LinboCacheUpdater::_startNextImages() {
+    if(!this->_running)
+        return;
+
+    int downloading = this->countWithStatus(Downloading);
+
+    // A formatting run has to finish before anything else is written to the cache
+    bool formatPending = this->_format && this->countWithStatus(Done) == 0;
+    int concurrency = formatPending ? 1 : this->_concurrency;
+
+    for(int i = 0; i < this->_images.length() && downloading < concurrency; i++) {
+        if(this->_images[i].status != Waiting)
+            continue;
+
+        if(this->_startImage(i))
+            downloading++;
+        else {
+            this->_logger->_log("Could not start cache update of " + this->imageName(i), LinboLogger::LinboGuiError);
+            this->_setStatus(i, Failed);
+        }
+    }
+
+    if(downloading == 0 && this->countWithStatus(Waiting) == 0) {
+        this->_running = false;
+        emit this->finished(!this->hasFailedImages());
+    }
+}
+
+bool LinboCacheUpdater::_startImage(int index) {
+    ImageState& state = this->_images[index];
+    bool format = this->_format && this->countWithStatus(Done) == 0;
+
+    state.attempts++;
+    state.latestOutput = "";
+    this->_logger->_log("Updating cache for " + this->imageName(index) + " (attempt " + QString::number(state.attempts) + " of " + QString::number(this->_maxAttempts) + ")", LinboLogger::LinboGuiInfo);
+
+    QProcess* process = this->_linboCmd->updateCacheOfImage(this->_downloadMethod, format, state.image, this->_serverIP, this->_cachePath, this);
+    if(process == nullptr)
+        return false;
+
+    state.process = process;
+    connect(process, &QProcess::readyReadStandardOutput, this, [=] {
+        this->_readOutput(this->_indexOf(process), false);
+    });
+    connect(process, &QProcess::readyReadStandardError, this, [=] {
+        this->_readOutput(this->_indexOf(process), true);
+    });
+    connect(process, &QProcess::finished, this, [=](int exitCode, QProcess::ExitStatus exitStatus) {
+        int index = this->_indexOf(process);
+        process->deleteLater();
+        if(index < 0)
+            return;
+        this->_images[index].process = nullptr;
+        this->_handleImageFinished(index, exitCode == 0 && exitStatus == QProcess::NormalExit);
+    });
+
+    this->_setStatus(index, Downloading);
+    return true;
+}
+
+void LinboCacheUpdater::_readOutput(int index, bool stdErr) {
+    if(index < 0)
+        return;
+
+    QProcess* process = this->_images[index].process;
+    if(process == nullptr)
+        return;
+
+    QString output = stdErr ? process->readAllStandardError() : process->readAllStandardOutput();
+    for(const QString &line : output.split("\n")) {
+        QString simplifiedLine = line.simplified();
+        if(simplifiedLine.isEmpty())
+            continue;
+
+        QString logText = "[" + this->imageName(index) + "] " + simplifiedLine;
+        if(stdErr)
+            this->_logger->stdErr(logText);
+        else
+            this->_logger->stdOut(logText);
+
+        this->_images[index].latestOutput = simplifiedLine;
+    }
+
+    emit this->progressChanged(index);
+}
+
+void LinboCacheUpdater::_handleImageFinished(int index, bool successful) {
+    if(index < 0 || index >= this->_images.length())
+        return;
+
+    if(successful) {
+        this->_logger->_log("Cache update of " + this->imageName(index) + " finished", LinboLogger::LinboGuiInfo);
+        this->_setStatus(index, Done);
+    }
+    else if(this->_running && this->_images[index].attempts < this->_maxAttempts) {
+        this->_logger->_log("Cache update of " + this->imageName(index) + " failed, retrying", LinboLogger::LinboGuiError);
+        this->_setStatus(index, Waiting);
+    }
+    else {
+        this->_logger->_log("Cache update of " + this->imageName(index) + " failed", LinboLogger::LinboGuiError);
+        this->_setStatus(index, Failed);
+    }
+
+    if(!this->_running) {
+        // killed, report once the last process is gone
+        if(this->countWithStatus(Downloading) == 0)
+            emit this->finished(false);
+        return;
+    }
+
+    // When formatting failed, there is no point in downloading the other images
+    if(!successful && this->_format && this->countWithStatus(Done) == 0 && this->_images[index].status == Failed) {
+        for(int i = 0; i < this->_images.length(); i++)
+            if(this->_images[i].status == Waiting)
+                this->_setStatus(i, Failed);
+    }
+
+    this->_startNextImages();
+}
+
+void LinboCacheUpdater::_setStatus(int index, ImageStatus status) {
+    if(this->_images[index].status == status)
+        return;
+
+    this->_images[index].status = status;
+    emit this->imageStatusChanged(index);
+}
+
+int LinboCacheUpdater::_indexOf(QProcess* process) {
+    for(int i = 0; i < this->_images.length(); i++)
+        if(this->_images[i].process == process)
+            return i;
+    return -1;
+}
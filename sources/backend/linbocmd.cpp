@@ -12,6 +12,15 @@ LinboCmd::LinboCmd(LinboLogger* logger, QObject *parent)
     connect(this->_asynchronosProcess, &QProcess::readyReadStandardOutput, this, &LinboCmd::_readFromStdout);
     connect(this->_asynchronosProcess, &QProcess::readyReadStandardError, this, &LinboCmd::_readFromStderr);
     connect(this->_asynchronosProcess, &QProcess::finished, this, &LinboCmd::commandFinished);
+    // after commandFinished, so the final log entries are still attributed to the command
+    connect(this->_asynchronosProcess, &QProcess::finished, this, [=] {
+        this->_logger->_setSourceCommand("");
+    });
+
+    this->_backgroundProcess = new QProcess(this);
+    connect(this->_backgroundProcess, &QProcess::readyReadStandardOutput, this, &LinboCmd::_readFromBackgroundStdout);
+    connect(this->_backgroundProcess, &QProcess::readyReadStandardError, this, &LinboCmd::_readFromBackgroundStderr);
+    connect(this->_backgroundProcess, &QProcess::finished, this, &LinboCmd::backgroundCommandFinished);
 
     // synchronos commands are not logged
     this->_synchronosProcess = new QProcess(this);
@@ -45,6 +54,22 @@ bool LinboCmd::syncOs(LinboOs* os, QString serverIP, QString cachePath) {
            );
 }
 
+bool LinboCmd::syncOsWithoutStart(LinboOs* os, QString serverIP, QString cachePath) {
+    // same as reinstall, but without "force" only changed files are synced
+    return this->executeAsync(
+               "syncr",
+               serverIP,
+               cachePath,
+               os->baseImage()->name(),
+               "",
+               os->bootPartition(),
+               os->rootPartition(),
+               os->kernel(),
+               os->initrd(),
+               os->kernelOptions()
+           );
+}
+
 bool LinboCmd::reinstallOs(LinboOs* os, QString serverIP, QString cachePath) {
     return this->executeAsync(
                "syncr",
@@ -66,6 +91,17 @@ bool LinboCmd::authenticate(QString password, QString serverIP) {
     return exitCode == 0;
 }
 
+QProcess* LinboCmd::startAuthentication(QString password, QString serverIP, QObject* parent) {
+    // not through _logExecution(), nothing masks the password before a login
+    if(this->_logger != nullptr)
+        this->_logger->info("Executing: " + this->_linboCmdCommand + " authenticate " + serverIP + " linbo ***");
+
+    // does not wait for the process, the caller handles QProcess::finished and QProcess::errorOccurred
+    QProcess* process = new QProcess(parent);
+    process->start(this->_linboCmdCommand, this->_buildCommand("authenticate", serverIP, "linbo", password));
+    return process;
+}
+
 bool LinboCmd::createImageOfOs(LinboOs* os, QString name, QString cachePath) {
     return this->executeAsync(
                "create",
@@ -79,8 +115,8 @@ bool LinboCmd::createImageOfOs(LinboOs* os, QString name, QString cachePath) {
            );
 }
 
-bool LinboCmd::uploadImage(LinboImage *image, QString password, QString serverIP, QString cachePath) {
-    return this->executeAsync(
+bool LinboCmd::uploadImage(LinboImage *image, QString password, QString serverIP, QString cachePath, bool inBackground) {
+    QStringList arguments = this->_buildCommand(
                "upload",
                serverIP,
                "linbo",
@@ -88,6 +124,10 @@ bool LinboCmd::uploadImage(LinboImage *image, QString password, QString serverIP
                cachePath,
                image->name()
            );
+
+    if(inBackground)
+        return this->executeAsyncInBackground(arguments);
+    return this->executeAsync(arguments);
 }
 
 bool LinboCmd::partitionDrive(QList<LinboDiskPartition*> paritions, bool format) {
@@ -104,23 +144,19 @@ bool LinboCmd::partitionDrive(QList<LinboDiskPartition*> paritions, bool format)
     return this->executeAsync(commandArgs);
 }
 
-bool LinboCmd::updateCache(LinboConfig::DownloadMethod downloadMethod, bool format, QList<LinboOs*> operaringSystems, QString serverIP, QString cachePath) {
+QProcess* LinboCmd::updateCacheOfImage(LinboConfig::DownloadMethod downloadMethod, bool format, LinboImage* image, QString serverIP, QString cachePath, QObject* parent) {
     QStringList commandArgs;
     commandArgs
             << (format ? "initcache_format":"initcache")
             << serverIP
-            << cachePath;
+            << cachePath
+            << LinboConfig::downloadMethodToString(downloadMethod);
 
+    // without an image, only the cache itself is initialized (and formatted)
+    if(image != nullptr)
+        commandArgs << image->name() << "";
 
-    commandArgs.append(LinboConfig::downloadMethodToString(downloadMethod));
-
-    for(LinboOs* os : operaringSystems) {
-        commandArgs
-                << os->baseImage()->name()
-                << "";
-    }
-
-    return this->executeAsync(commandArgs);
+    return this->startProcess(commandArgs, parent);
 }
 
 bool LinboCmd::updateLinbo(QString serverIP, QString cachePath) {
@@ -183,10 +219,32 @@ bool LinboCmd::writeImageDescription(QString imageName, QString newDescription,
 
 bool LinboCmd::executeAsync(QStringList arguments) {
     this->_logExecution(arguments);
+    this->_logger->_setSourceCommand(arguments.value(0));
     _asynchronosProcess->start(this->_linboCmdCommand, arguments);
     return _asynchronosProcess->waitForStarted();
 }
 
+bool LinboCmd::executeAsyncInBackground(QStringList arguments) {
+    if(this->_backgroundProcess->state() != QProcess::NotRunning)
+        return false;
+
+    this->_logExecution(arguments);
+    this->_backgroundProcess->start(this->_linboCmdCommand, arguments);
+    return this->_backgroundProcess->waitForStarted();
+}
+
+QProcess* LinboCmd::startProcess(QStringList arguments, QObject* parent) {
+    // The caller owns the process and is responsible for its output
+    this->_logExecution(arguments);
+    QProcess* process = new QProcess(parent);
+    process->start(this->_linboCmdCommand, arguments);
+    if(!process->waitForStarted()) {
+        delete process;
+        return nullptr;
+    }
+    return process;
+}
+
 int LinboCmd::executeSync(QStringList arguments) {
     this->_logExecution(arguments);
     // clear old output
@@ -220,6 +278,14 @@ void LinboCmd::killAsyncProcess() {
     this->_asynchronosProcess->kill();
 }
 
+void LinboCmd::killBackgroundProcess() {
+    this->_backgroundProcess->kill();
+}
+
+bool LinboCmd::isBackgroundProcessRunning() {
+    return this->_backgroundProcess->state() != QProcess::NotRunning;
+}
+
 void LinboCmd::setStringToMaskInOutput(QString string) {
     this->_stringToMaskInOutput = string;
 }
@@ -244,6 +310,26 @@ void LinboCmd::_readFromStderr() {
     }
 }
 
+void LinboCmd::_readFromBackgroundStdout() {
+    if(this->_logger == nullptr)
+        return;
+    QString stdOut = this->_backgroundProcess->readAllStandardOutput();
+    QStringList lines = stdOut.split("\n");
+    for(const QString &line : lines) {
+        this->_logger->backgroundStdOut(line.simplified());
+    }
+}
+
+void LinboCmd::_readFromBackgroundStderr() {
+    if(this->_logger == nullptr)
+        return;
+    QString stdErr = this->_backgroundProcess->readAllStandardError();
+    QStringList lines = stdErr.split("\n");
+    for(const QString &line : lines) {
+        this->_logger->backgroundStdErr(line.simplified());
+    }
+}
+
 QString LinboCmd::_maskString(QString stringToMask) {
     if(!this->_stringToMaskInOutput.isEmpty())
         return stringToMask.replace(this->_stringToMaskInOutput, "***");
@@ -33,6 +33,19 @@ LinboConfig::LinboConfig(QObject *parent) : QObject(parent)
     this->_operatingSystems = {};
     this->_themeName = "";
     this->_clientDetailsVisibleByDefault = false;
+    this->_logArchiveEnabled = true;
+    this->_logArchiveMaxSize = 64;
+    this->_logArchiveMaxAge = 30;
+    // one linbo_cmd at a time like before, several processes all mount the cache and run the non-image steps
+    this->_initCacheConcurrency = 1;
+    this->_initCacheRetries = 1;
+    this->_freshnessCheckInterval = 60;
+    this->_preDownload = false;
+    this->_preDownloadBandwidthLimit = 2048;
+    this->_autostartJitter = 0;
+    this->_autostartWindow = 0;
+    this->_controlSocket = "/tmp/linbo-gui.sock";
+    this->_animationFramesPerSecond = 0;
     this->_theme = new LinboTheme();
 }
 
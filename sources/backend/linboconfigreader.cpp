@@ -214,6 +214,23 @@ void LinboConfigReader::_loadLinboConfigFromBlock(QMap<QString, QString> rawLinb
         else if(key == "guidisabled")   c->_guiDisabled = this->_stringToBool(value);
         else if(key == "clientdetailsvisiblebydefault") c->_clientDetailsVisibleByDefault = this->_stringToBool(value);
         else if(key == "theme") c->_themeName = value;
+        else if(key == "logarchive")        c->_logArchiveEnabled = this->_stringToBool(value);
+        else if(key == "logarchivemaxsize") c->_logArchiveMaxSize = value.toInt();
+        else if(key == "logarchivemaxage")  c->_logArchiveMaxAge = value.toInt();
+        else if(key == "logconsole")        c->_logConsole = value;
+        else if(key == "logfile")           c->_logFile = value;
+        else if(key == "loghistory")        c->_logHistory = value;
+        else if(key == "logstructured")     c->_logStructured = value;
+        else if(key == "structuredlog" && c->_logStructured.isEmpty()) c->_logStructured = this->_stringToBool(value) ? "verbose" : "off";
+        else if(key == "initcacheconcurrency") c->_initCacheConcurrency = qMax(1, value.toInt());
+        else if(key == "initcacheretries")     c->_initCacheRetries = qMax(0, value.toInt());
+        else if(key == "freshnesscheckinterval") c->_freshnessCheckInterval = qMax(0, value.toInt());
+        else if(key == "predownload")       c->_preDownload = this->_stringToBool(value);
+        else if(key == "predownloadbwlimit") c->_preDownloadBandwidthLimit = qMax(0, value.toInt());
+        else if(key == "autostartjitter")   c->_autostartJitter = qMax(0, value.toInt());
+        else if(key == "autostartwindow")   c->_autostartWindow = qMax(0, value.toInt());
+        else if(key == "animationfps")      c->_animationFramesPerSecond = qMax(0, value.toInt());
+        else if(key == "controlsocket")     c->_controlSocket = value.toLower() == "off" ? "" : value;
         else this->_backend->logger()->info("Unknown [LINBO] field ignored: " + key);
     }
 }
@@ -0,0 +1,443 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbocontrolserver.h"
+#include "linbobackend.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <QMetaEnum>
+
+LinboControlServer::LinboControlServer(LinboBackend* backend, LinboLogger* logger) : QObject(backend)
+{
+    this->_backend = backend;
+    this->_logger = logger;
+    this->_serverSocket = -1;
+    this->_serverNotifier = nullptr;
+    this->_activityMonitor = nullptr;
+    this->_authentication = nullptr;
+    this->_authenticatingClient = nullptr;
+}
+
+LinboControlServer::~LinboControlServer() {
+    this->_close();
+    this->_deleteClosedClients();
+}
+
+bool LinboControlServer::_listen(QString socketPath) {
+    this->_close();
+
+    QByteArray path = socketPath.toLocal8Bit();
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(path.isEmpty() || path.length() >= int(sizeof(address.sun_path))) {
+        this->_logger->_log("Invalid control socket path: " + socketPath, LinboLogger::LinboGuiError);
+        return false;
+    }
+    memcpy(address.sun_path, path.constData(), path.length());
+
+    int serverSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(serverSocket < 0)
+        return false;
+
+    // a stale socket of a previous instance
+    unlink(path.constData());
+
+    // root actions need a login anyway, but the log must not be readable by everyone
+    mode_t previousMask = umask(0077);
+    bool bound = bind(serverSocket, (sockaddr*)&address, sizeof(address)) == 0;
+    umask(previousMask);
+
+    if(!bound || listen(serverSocket, 8) != 0) {
+        this->_logger->_log("Could not listen on control socket " + socketPath + ": " + QString::fromLocal8Bit(strerror(errno)), LinboLogger::LinboGuiError);
+        close(serverSocket);
+        return false;
+    }
+
+    this->_socketPath = socketPath;
+    this->_serverSocket = serverSocket;
+    if(this->_activityMonitor == nullptr)
+        this->_activityMonitor = new LinboActivityMonitor(this);
+    this->_serverNotifier = new QSocketNotifier(serverSocket, QSocketNotifier::Read, this);
+    connect(this->_serverNotifier, &QSocketNotifier::activated, this, &LinboControlServer::_acceptClients);
+
+    connect(this->_backend, &LinboBackend::stateChanged, this, [=](LinboBackend::LinboState state) {
+        this->_handleStateChanged(state);
+    });
+    connect(this->_backend, &LinboBackend::timeoutProgressChanged, this, &LinboControlServer::_handleTimeoutProgressChanged);
+    connect(this->_logger, &LinboLogger::latestLogChanged, this, &LinboControlServer::_handleLatestLogChanged);
+    connect(this->_logger, &LinboLogger::latestBackgroundLogChanged, this, &LinboControlServer::_handleLatestLogChanged);
+    connect(this->_backend->cacheUpdater(), &LinboCacheUpdater::imageStatusChanged, this, &LinboControlServer::_handleCacheImageChanged);
+    connect(this->_backend->cacheUpdater(), &LinboCacheUpdater::progressChanged, this, &LinboControlServer::_handleCacheImageChanged);
+    connect(this->_backend->jobQueue(), &LinboJobQueue::jobStatusChanged, this, &LinboControlServer::_handleJobStatusChanged);
+
+    this->_logger->_log("Listening on control socket " + socketPath, LinboLogger::LinboGuiInfo);
+    return true;
+}
+
+void LinboControlServer::_close() {
+    while(!this->_clients.isEmpty())
+        this->_disconnectClient(this->_clients.first());
+
+    if(this->_authentication != nullptr) {
+        this->_authentication->disconnect(this);
+        this->_authentication->kill();
+        this->_authentication->deleteLater();
+        this->_authentication = nullptr;
+    }
+
+    if(this->_serverSocket < 0)
+        return;
+
+    delete this->_serverNotifier;
+    this->_serverNotifier = nullptr;
+    close(this->_serverSocket);
+    this->_serverSocket = -1;
+    unlink(this->_socketPath.toLocal8Bit().constData());
+}
+
+// -- Clients --
+
+void LinboControlServer::_acceptClients() {
+    int socket;
+    while((socket = accept4(this->_serverSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+        Client* client = new Client {socket, nullptr, nullptr, QByteArray(), QByteArray(), 0, false, this->_activityMonitor->sample(), false};
+        client->readNotifier = new QSocketNotifier(socket, QSocketNotifier::Read, this);
+        client->writeNotifier = new QSocketNotifier(socket, QSocketNotifier::Write, this);
+        client->writeNotifier->setEnabled(false);
+        connect(client->readNotifier, &QSocketNotifier::activated, this, [=] {
+            this->_readFromClient(client);
+        });
+        connect(client->writeNotifier, &QSocketNotifier::activated, this, [=] {
+            this->_writeToClient(client);
+        });
+        this->_clients.append(client);
+
+        // a new client starts with the current state
+        this->_send(client, this->_stateRecord(), false);
+    }
+}
+
+void LinboControlServer::_readFromClient(Client* client) {
+    if(client->closed)
+        return;
+
+    char buffer[4096];
+    ssize_t length;
+    while((length = recv(client->socket, buffer, sizeof(buffer), 0)) > 0)
+        client->input.append(buffer, length);
+
+    if(length == 0 || (length < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        this->_disconnectClient(client);
+        return;
+    }
+
+    int newline;
+    while((newline = client->input.indexOf('\n')) >= 0) {
+        QByteArray line = client->input.left(newline).trimmed();
+        client->input.remove(0, newline + 1);
+        if(line.isEmpty())
+            continue;
+
+        QJsonParseError error;
+        QJsonDocument command = QJsonDocument::fromJson(line, &error);
+        if(error.error != QJsonParseError::NoError || !command.isObject())
+            this->_reply(client, "", false, "invalid json");
+        else
+            this->_handleCommand(client, command.object());
+
+        // the command might have disconnected the client
+        if(client->closed)
+            return;
+    }
+
+    if(client->input.length() > _maxLineLength)
+        this->_disconnectClient(client);
+}
+
+void LinboControlServer::_writeToClient(Client* client) {
+    if(client->closed)
+        return;
+
+    while(!client->output.isEmpty()) {
+        ssize_t written = send(client->socket, client->output.constData(), client->output.length(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if(written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if(written < 0) {
+            this->_disconnectClient(client);
+            return;
+        }
+        client->output.remove(0, written);
+    }
+
+    // tell the client about what it missed once it caught up
+    if(client->droppedRecords > 0 && client->output.length() < _droppingThreshold / 2) {
+        QJsonObject dropped {{"type", "dropped"}, {"count", client->droppedRecords}};
+        client->droppedRecords = 0;
+        this->_send(client, dropped, false);
+        return;
+    }
+
+    client->writeNotifier->setEnabled(!client->output.isEmpty());
+}
+
+void LinboControlServer::_disconnectClient(Client* client) {
+    if(client->closed)
+        return;
+
+    // a client is disconnected while sending, possibly deep inside a command handler that still uses it,
+    // so it is only marked as closed here and deleted once control is back in the event loop
+    client->closed = true;
+    this->_clients.removeAll(client);
+    client->readNotifier->setEnabled(false);
+    client->writeNotifier->setEnabled(false);
+    client->readNotifier->deleteLater();
+    client->writeNotifier->deleteLater();
+    close(client->socket);
+    client->socket = -1;
+
+    // a login which is still being checked is not answered anymore
+    if(this->_authenticatingClient == client)
+        this->_authenticatingClient = nullptr;
+
+    if(this->_closedClients.isEmpty())
+        QMetaObject::invokeMethod(this, &LinboControlServer::_deleteClosedClients, Qt::QueuedConnection);
+    this->_closedClients.append(client);
+}
+
+void LinboControlServer::_deleteClosedClients() {
+    qDeleteAll(this->_closedClients);
+    this->_closedClients.clear();
+}
+
+// -- Commands --
+
+void LinboControlServer::_handleCommand(Client* client, const QJsonObject& command) {
+    QString name = command.value("command").toString();
+
+    if(name == "state") {
+        this->_send(client, this->_stateRecord(), false);
+        this->_reply(client, name, true);
+    }
+    else if(name == "activity") {
+        LinboActivityMonitor::Sample sample = this->_activityMonitor->sample();
+        this->_send(client, {
+            {"type", "activity"},
+            {"seconds", double(sample.milliseconds - client->activitySample.milliseconds) / 1000},
+            {"paintEventsPerSecond", LinboActivityMonitor::paintEventsPerSecond(client->activitySample, sample)},
+            {"wakeupsPerSecond", LinboActivityMonitor::wakeupsPerSecond(client->activitySample, sample)}
+        }, false);
+        client->activitySample = sample;
+        this->_reply(client, name, true);
+    }
+    else if(name == "start" || name == "sync" || name == "reinstall") {
+        LinboOs* os = nullptr;
+        for(LinboOs* candidate : this->_backend->config()->operatingSystems())
+            if(candidate->name() == command.value("os").toString())
+                os = candidate;
+
+        if(os == nullptr) {
+            this->_reply(client, name, false, "unknown os");
+            return;
+        }
+
+        bool ok = name == "start" ? os->executeStart() : name == "sync" ? os->executeSync() : os->executeReinstall();
+        this->_reply(client, name, ok);
+    }
+    else if(name == "cancel") {
+        // start actions can be cancelled by anyone who could press the cancel button
+        if(this->_backend->state() > LinboBackend::Root && !client->authenticated) {
+            this->_reply(client, name, false, "login required");
+            return;
+        }
+        this->_reply(client, name, this->_backend->cancelCurrentAction());
+    }
+    else if(name == "login") {
+        // one check at a time and a pause after each failed one, for all connections together
+        if(this->_authentication != nullptr || !this->_loginDelay.hasExpired()) {
+            this->_reply(client, name, false, "try again later");
+            return;
+        }
+        this->_authenticate(client, command.value("password").toString());
+    }
+    else if(name == "initcache" || name == "logout") {
+        if(!client->authenticated) {
+            this->_reply(client, name, false, "login required");
+            return;
+        }
+
+        if(name == "logout") {
+            client->authenticated = false;
+            this->_reply(client, name, true);
+            return;
+        }
+
+        LinboConfig::DownloadMethod downloadMethod = command.contains("method")
+                ? LinboConfig::stringToDownloadMethod(command.value("method").toString())
+                : this->_backend->config()->downloadMethod();
+        this->_reply(client, name, this->_backend->_updateCacheForControlClient(downloadMethod, command.value("format").toBool()));
+    }
+    else {
+        this->_reply(client, name, false, "unknown command");
+    }
+}
+
+void LinboControlServer::_reply(Client* client, QString command, bool ok, QString error) {
+    QJsonObject reply {{"type", "reply"}, {"command", command}, {"ok", ok}};
+    if(!error.isEmpty())
+        reply.insert("error", error);
+    this->_send(client, reply, false);
+}
+
+void LinboControlServer::_authenticate(Client* client, QString password) {
+    // linbo_cmd asks the server, that must not block the gui
+    this->_authenticatingClient = client;
+    this->_authentication = this->_backend->_linboCmd->startAuthentication(password, this->_backend->config()->serverIpAddress(), this);
+    connect(this->_authentication, &QProcess::finished, this, [=](int exitCode, QProcess::ExitStatus exitStatus) {
+        this->_handleAuthenticationFinished(exitCode == 0 && exitStatus == QProcess::NormalExit);
+    });
+    connect(this->_authentication, &QProcess::errorOccurred, this, [=](QProcess::ProcessError error) {
+        if(error == QProcess::FailedToStart)
+            this->_handleAuthenticationFinished(false);
+    });
+}
+
+void LinboControlServer::_handleAuthenticationFinished(bool successful) {
+    this->_authentication->deleteLater();
+    this->_authentication = nullptr;
+
+    if(!successful) {
+        this->_loginDelay.setRemainingTime(_failedLoginDelay);
+        this->_logger->_log("Control socket login failed", LinboLogger::LinboGuiError);
+    }
+
+    Client* client = this->_authenticatingClient;
+    this->_authenticatingClient = nullptr;
+    if(client == nullptr)
+        return;
+
+    client->authenticated = successful;
+    this->_reply(client, "login", successful, successful ? "" : "authentication failed");
+}
+
+// -- Records --
+
+void LinboControlServer::_broadcast(const QJsonObject& record, bool droppable) {
+    // copy, as a client might be disconnected while sending
+    const QList<Client*> clients = this->_clients;
+    for(Client* client : clients)
+        this->_send(client, record, droppable);
+}
+
+void LinboControlServer::_send(Client* client, const QJsonObject& record, bool droppable) {
+    if(client->closed)
+        return;
+
+    if(droppable && (client->output.length() > _droppingThreshold || client->droppedRecords > 0)) {
+        client->droppedRecords++;
+        return;
+    }
+
+    client->output.append(QJsonDocument(record).toJson(QJsonDocument::Compact));
+    client->output.append('\n');
+
+    if(client->output.length() > _disconnectThreshold) {
+        this->_disconnectClient(client);
+        return;
+    }
+
+    this->_writeToClient(client);
+}
+
+QJsonObject LinboControlServer::_stateRecord() {
+    QJsonObject record {
+        {"type", "state"},
+        {"state", QMetaEnum::fromType<LinboBackend::LinboState>().valueToKey(this->_backend->state())}
+    };
+    if(this->_backend->osOfCurrentAction() != nullptr)
+        record.insert("os", this->_backend->osOfCurrentAction()->name());
+    return record;
+}
+
+void LinboControlServer::_handleStateChanged(int state) {
+    // the root session of every connection ends with the one of the gui or the cache update
+    if(state == LinboBackend::Idle) {
+        for(Client* client : qAsConst(this->_clients))
+            client->authenticated = false;
+    }
+
+    this->_broadcast(this->_stateRecord(), false);
+}
+
+void LinboControlServer::_handleLatestLogChanged(const LinboLogger::LinboLog& latestLog) {
+    if(this->_clients.isEmpty())
+        return;
+
+    this->_broadcast({
+        {"type", "log"},
+        {"logType", LinboLogger::logTypeToString(latestLog.type)},
+        {"chapter", qint64(latestLog.chapter)},
+        {"time", latestLog.time.toString(Qt::ISODateWithMs)},
+        {"message", latestLog.message}
+    }, true);
+}
+
+void LinboControlServer::_handleTimeoutProgressChanged(double progress, int remainingMilliseconds) {
+    if(this->_clients.isEmpty())
+        return;
+
+    this->_broadcast({
+        {"type", "progress"},
+        {"source", "countdown"},
+        {"progress", progress},
+        {"remainingMs", remainingMilliseconds}
+    }, true);
+}
+
+void LinboControlServer::_handleCacheImageChanged(int index) {
+    if(this->_clients.isEmpty())
+        return;
+
+    LinboCacheUpdater* cacheUpdater = this->_backend->cacheUpdater();
+    this->_broadcast({
+        {"type", "progress"},
+        {"source", "cache"},
+        {"image", cacheUpdater->imageName(index)},
+        {"status", LinboCacheUpdater::statusToString(cacheUpdater->status(index))},
+        {"attempts", cacheUpdater->attempts(index)},
+        {"output", cacheUpdater->latestOutput(index)}
+    }, true);
+}
+
+void LinboControlServer::_handleJobStatusChanged(LinboJob* job) {
+    if(this->_clients.isEmpty())
+        return;
+
+    // job status changes are rare and important, they are never dropped
+    this->_broadcast({
+        {"type", "job"},
+        {"job", job->toString()},
+        {"status", LinboJob::statusToString(job->status())}
+    }, false);
+}
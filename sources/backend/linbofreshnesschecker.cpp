@@ -0,0 +1,391 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbofreshnesschecker.h"
+#include "linbobackend.h"
+#include "linbocachemount.h"
+
+#include <cstdio>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#endif
+
+LinboFreshnessChecker::LinboFreshnessChecker(LinboBackend* backend, LinboLogger* logger, LinboConfig* config) : QObject(backend)
+{
+    this->_backend = backend;
+    this->_logger = logger;
+    this->_config = config;
+    this->_process = nullptr;
+    this->_stagingDir = nullptr;
+    this->_currentImage = nullptr;
+    this->_downloading = false;
+
+    this->_timer = new QTimer(this);
+    this->_timer->setSingleShot(true);
+    connect(this->_timer, &QTimer::timeout, this, &LinboFreshnessChecker::_startRound);
+
+    connect(this->_backend, &LinboBackend::stateChanged, this, [=](LinboBackend::LinboState state) {
+        this->_handleBackendStateChanged(state);
+    });
+}
+
+void LinboFreshnessChecker::_handleBackendStateChanged(int state) {
+    if(state == LinboBackend::Idle)
+        this->_resume();
+    else
+        this->_pause();
+}
+
+void LinboFreshnessChecker::_resume() {
+    if(this->_config->freshnessCheckInterval() <= 0 || this->_timer->isActive() || this->isRunning())
+        return;
+
+    // Do not start right away, the user might just be about to do something
+    qint64 interval = qint64(this->_config->freshnessCheckInterval()) * 60 * 1000;
+    qint64 remaining = _startDelay;
+    if(this->_pendingImages.isEmpty() && this->_imagesToDownload.isEmpty() && this->_sinceLastRound.isValid())
+        remaining = qMax(remaining, interval - this->_sinceLastRound.elapsed());
+
+    this->_timer->start(int(qMin(remaining, interval)));
+}
+
+void LinboFreshnessChecker::_pause() {
+    this->_timer->stop();
+
+    if(this->_process != nullptr) {
+        // the image is checked or downloaded again once Linbo is idle, rsync keeps the partial download.
+        // The process deletes itself once it is gone.
+        this->_process->disconnect(this);
+        connect(this->_process, &QProcess::finished, this->_process, &QObject::deleteLater);
+        this->_process->kill();
+
+        // rsync keeps the cache busy until it is gone, unmounting before would fail
+        if(!this->_process->waitForFinished(1000) && !this->_mountPoint.isEmpty()) {
+            // the reference is handed over to the process, a new round takes its own
+            QString cachePath = this->_config->cachePath();
+            connect(this->_process, &QProcess::finished, this->_process, [=] {
+                LinboCacheMount::release(cachePath);
+            });
+            this->_mountPoint = "";
+        }
+        this->_process = nullptr;
+        if(this->_currentImage != nullptr && this->_downloading)
+            this->_imagesToDownload.prepend(this->_currentImage);
+        else if(this->_currentImage != nullptr)
+            this->_pendingImages.prepend(this->_currentImage);
+        this->_currentImage = nullptr;
+        this->_downloading = false;
+        this->_logger->_log("Paused image freshness check", LinboLogger::LinboGuiInfo);
+    }
+
+    // linbo_cmd has to find the cache the way it left it
+    this->_releaseCache();
+}
+
+void LinboFreshnessChecker::_startRound() {
+    if(this->_backend->state() != LinboBackend::Idle)
+        return;
+
+    if(this->_pendingImages.isEmpty() && this->_imagesToDownload.isEmpty()) {
+        for(LinboOs* os : this->_config->operatingSystems()) {
+            if(os->baseImage() != nullptr && !this->_pendingImages.contains(os->baseImage()))
+                this->_pendingImages.append(os->baseImage());
+        }
+    }
+
+    this->_releaseCache();
+    this->_mountPoint = LinboCacheMount::acquire(this->_config->cachePath());
+    if(this->_mountPoint.isEmpty()) {
+        this->_logger->_log("Could not check image freshness, the cache is not available", LinboLogger::LinboGuiError);
+        this->_pendingImages.clear();
+        this->_imagesToDownload.clear();
+        this->_finishRound();
+        return;
+    }
+
+    emit this->cacheMounted();
+
+    if(this->_stagingDir == nullptr)
+        this->_stagingDir = new QTemporaryDir();
+
+    this->_checkNextImage();
+}
+
+void LinboFreshnessChecker::_checkNextImage() {
+    if(this->_pendingImages.isEmpty()) {
+        this->_downloadNextImage();
+        return;
+    }
+
+    LinboImage* image = this->_pendingImages.takeFirst();
+    if(!QFile::exists(this->_localImagePath(image))) {
+        image->_setFreshness(LinboImage::Missing);
+        this->_checkNextImage();
+        return;
+    }
+
+    this->_currentImage = image;
+    QFile::remove(this->_stagingDir->filePath(image->name() + ".info"));
+    QFile::remove(this->_stagingDir->filePath(image->name() + ".md5"));
+
+    // Only the small metadata files are transferred, additional sources on the same server start with ::
+    QString remoteImagePath = this->_remoteImagePath(image);
+    QStringList arguments = {
+        "--timeout=30",
+        this->_config->serverIpAddress() + "::linbo/" + remoteImagePath + ".info",
+        "::linbo/" + remoteImagePath + ".md5",
+        this->_stagingDir->path() + "/"
+    };
+
+    this->_startProcess(arguments);
+}
+
+void LinboFreshnessChecker::_downloadNextImage() {
+    if(this->_imagesToDownload.isEmpty() || !this->_config->preDownload()) {
+        this->_imagesToDownload.clear();
+        this->_finishRound();
+        return;
+    }
+
+    LinboImage* image = this->_imagesToDownload.takeFirst();
+    QString stagingPath = this->_stagingPath(image);
+
+    // without the size from the .info, there is no telling whether the image fits
+    qint64 remoteImageSize = this->_remoteImageSizes.value(image, 0);
+    if(remoteImageSize <= 0) {
+        this->_logger->_log("Not pre-downloading " + image->name() + ", its size on the server is unknown", LinboLogger::LinboGuiError);
+        this->_downloadNextImage();
+        return;
+    }
+
+    // the staged copy must fit next to the current one
+    QStorageInfo storage(this->_mountPoint);
+    qint64 alreadyStaged = QFileInfo(stagingPath + "/" + image->name()).size();
+    if(storage.bytesAvailable() + alreadyStaged < remoteImageSize * 11 / 10) {
+        this->_logger->_log("Not enough space in the cache to pre-download " + image->name(), LinboLogger::LinboGuiError);
+        this->_downloadNextImage();
+        return;
+    }
+
+    QDir().mkpath(stagingPath);
+    this->_currentImage = image;
+    this->_downloading = true;
+    this->_logger->_log("Pre-downloading " + image->name(), LinboLogger::LinboGuiInfo);
+
+    // The image with all of its metadata files, a partial image is resumed next time
+    QStringList arguments = {
+        "--timeout=60",
+        "--partial",
+        "--times"
+    };
+    if(this->_config->preDownloadBandwidthLimit() > 0)
+        arguments << "--bwlimit=" + QString::number(this->_config->preDownloadBandwidthLimit());
+    arguments
+        << this->_config->serverIpAddress() + "::linbo/" + this->_remoteImagePath(image) + "*"
+        << stagingPath + "/";
+
+    this->_startProcess(arguments);
+}
+
+void LinboFreshnessChecker::_startProcess(QStringList arguments) {
+    this->_process = new QProcess(this);
+#ifdef Q_OS_LINUX
+    this->_process->setChildProcessModifier([] {
+        // idle io class, the check must never slow down anything else
+        syscall(SYS_ioprio_set, 1, 0, 3 << 13);
+        setpriority(PRIO_PROCESS, 0, 19);
+    });
+#endif
+    connect(this->_process, &QProcess::finished, this, &LinboFreshnessChecker::_handleProcessFinished);
+    connect(this->_process, &QProcess::errorOccurred, this, [=](QProcess::ProcessError error) {
+        if(error == QProcess::FailedToStart)
+            this->_handleProcessFinished(-1, QProcess::CrashExit);
+    });
+    this->_process->start("rsync", arguments);
+}
+
+void LinboFreshnessChecker::_handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus) {
+    this->_process->deleteLater();
+    this->_process = nullptr;
+
+    LinboImage* image = this->_currentImage;
+    this->_currentImage = nullptr;
+
+    if(this->_downloading) {
+        this->_downloading = false;
+        if(exitCode == 0 && exitStatus == QProcess::NormalExit && this->_swapInStagedImage(image)) {
+            this->_logger->_log("Pre-downloaded " + image->name(), LinboLogger::LinboGuiInfo);
+            image->_setFreshness(LinboImage::Fresh);
+        }
+        else {
+            // checked and downloaded again in the next round
+            this->_logger->_log("Pre-downloading " + image->name() + " failed", LinboLogger::LinboGuiError);
+        }
+
+        this->_downloadNextImage();
+        return;
+    }
+
+    // a missing .md5 fails the transfer, but the .info is enough to compare
+    if(QFile::exists(this->_stagingDir->filePath(image->name() + ".info")))
+        image->_setFreshness(this->_compare(image));
+    else
+        image->_setFreshness(LinboImage::UnknownFreshness);
+
+    if(image->freshness() == LinboImage::Stale && !this->_imagesToDownload.contains(image))
+        this->_imagesToDownload.append(image);
+
+    this->_checkNextImage();
+}
+
+LinboImage::ImageFreshness LinboFreshnessChecker::_compare(LinboImage* image) {
+    QString localImagePath = this->_localImagePath(image);
+    QByteArray remoteInfo = _readFile(this->_stagingDir->filePath(image->name() + ".info"));
+    QByteArray localInfo = _readFile(localImagePath + ".info");
+
+    // imagesize="123456", needed to pre-download a stale image as well
+    static const QRegularExpression imageSizeRegex("imagesize=\"?(\\d+)\"?");
+    QRegularExpressionMatch match = imageSizeRegex.match(QString::fromUtf8(remoteInfo));
+    if(match.hasMatch())
+        this->_remoteImageSizes[image] = match.captured(1).toLongLong();
+    else
+        this->_remoteImageSizes.remove(image);
+
+    if(localInfo.isEmpty() || localInfo.trimmed() != remoteInfo.trimmed())
+        return LinboImage::Stale;
+
+    if(match.hasMatch() && match.captured(1).toLongLong() != QFileInfo(localImagePath).size())
+        return LinboImage::Stale;
+
+    QByteArray remoteMd5 = _readFile(this->_stagingDir->filePath(image->name() + ".md5"));
+    QByteArray localMd5 = _readFile(localImagePath + ".md5");
+    if(!remoteMd5.isEmpty() && !localMd5.isEmpty() && remoteMd5.trimmed() != localMd5.trimmed())
+        return LinboImage::Stale;
+
+    return LinboImage::Fresh;
+}
+
+void LinboFreshnessChecker::_finishRound() {
+    this->_pruneStagingDirectories();
+    this->_releaseCache();
+    delete this->_stagingDir;
+    this->_stagingDir = nullptr;
+
+    QMap<LinboImage::ImageFreshness, int> counts;
+    for(LinboOs* os : this->_config->operatingSystems())
+        if(os->baseImage() != nullptr)
+            counts[os->baseImage()->freshness()]++;
+
+    this->_logger->_log(
+        "Image freshness check finished: "
+        + QString::number(counts[LinboImage::Fresh]) + " fresh, "
+        + QString::number(counts[LinboImage::Stale]) + " stale, "
+        + QString::number(counts[LinboImage::Missing]) + " missing",
+        LinboLogger::LinboGuiInfo
+    );
+
+    this->_sinceLastRound.start();
+    this->_resume();
+}
+
+void LinboFreshnessChecker::_pruneStagingDirectories() {
+    if(this->_mountPoint.isEmpty())
+        return;
+
+    // a partial download is only kept as long as it is going to be continued
+    QStringList stillStaged;
+    if(this->_config->preDownload()) {
+        for(LinboOs* os : this->_config->operatingSystems())
+            if(os->baseImage() != nullptr && os->baseImage()->freshness() == LinboImage::Stale)
+                stillStaged.append(_baseName(os->baseImage()));
+    }
+
+    QDir stagingRoot(this->_mountPoint + "/.linbo-staging");
+    if(!stagingRoot.exists())
+        return;
+
+    for(const QString& directory : stagingRoot.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if(stillStaged.contains(directory))
+            continue;
+
+        this->_logger->_log("Removing orphaned pre-download " + directory, LinboLogger::LinboGuiInfo);
+        QDir(stagingRoot.filePath(directory)).removeRecursively();
+    }
+
+    if(stagingRoot.isEmpty())
+        stagingRoot.removeRecursively();
+}
+
+void LinboFreshnessChecker::_releaseCache() {
+    if(!this->_mountPoint.isEmpty())
+        LinboCacheMount::release(this->_config->cachePath());
+    this->_mountPoint = "";
+}
+
+bool LinboFreshnessChecker::_swapInStagedImage(LinboImage* image) {
+    QDir stagingDir(this->_stagingPath(image));
+    QString targetDir = QFileInfo(this->_localImagePath(image)).absolutePath();
+
+    if(!stagingDir.exists(image->name()) || !stagingDir.exists(image->name() + ".info"))
+        return false;
+
+    // The image goes first and the .info last, so an interrupted swap is detected as stale and not as fresh.
+    // rename() replaces each file atomically as staging and cache are on the same file system.
+    QStringList files = stagingDir.entryList(QDir::Files);
+    files.removeAll(image->name());
+    files.removeAll(image->name() + ".info");
+    files.prepend(image->name());
+    files.append(image->name() + ".info");
+
+    for(const QString& file : files) {
+        if(std::rename(stagingDir.filePath(file).toUtf8().constData(), (targetDir + "/" + file).toUtf8().constData()) != 0)
+            return false;
+    }
+
+    stagingDir.removeRecursively();
+    return true;
+}
+
+QString LinboFreshnessChecker::_localImagePath(LinboImage* image) {
+    return LinboCacheMount::imagePath(this->_mountPoint, image->name());
+}
+
+QString LinboFreshnessChecker::_remoteImagePath(LinboImage* image) {
+    // the server uses the same layout as the cache
+    if(this->_localImagePath(image).endsWith("/" + _baseName(image) + "/" + image->name()))
+        return "images/" + _baseName(image) + "/" + image->name();
+    return image->name();
+}
+
+QString LinboFreshnessChecker::_stagingPath(LinboImage* image) {
+    return this->_mountPoint + "/.linbo-staging/" + _baseName(image);
+}
+
+QString LinboFreshnessChecker::_baseName(LinboImage* image) {
+    return image->name().section(".", 0, 0);
+}
+
+QByteArray LinboFreshnessChecker::_readFile(QString path) {
+    QFile file(path);
+    if(!file.open(QFile::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
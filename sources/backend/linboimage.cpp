@@ -24,6 +24,7 @@ LinboImage::LinboImage(QString name, LinboBackend *parent) : QObject(parent)
     this->_backend = parent;
     this->_os = nullptr;
     this->_existsOnDisk = false;
+    this->_freshness = UnknownFreshness;
     this->_name = name;
 }
 
@@ -39,3 +40,11 @@ bool LinboImage::setDescription (const QString& description) {
 bool LinboImage::upload(LinboPostProcessActions::Flags postProcessActions) {
     return this->_backend->uploadImage(this, postProcessActions);
 }
+
+void LinboImage::_setFreshness(ImageFreshness freshness) {
+    if(this->_freshness == freshness)
+        return;
+
+    this->_freshness = freshness;
+    emit this->freshnessChanged(freshness);
+}
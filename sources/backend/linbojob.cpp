@@ -0,0 +1,133 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbojob.h"
+
+LinboJob::LinboJob(JobType type, LinboOs* os, QObject* parent) : QObject(parent)
+{
+    this->_type = type;
+    this->_os = os;
+    this->_status = Pending;
+    this->_failurePolicy = AbortOnFailure;
+    // invalid -> the download method from start.conf is used
+    this->_downloadMethod = LinboConfig::DownloadMethod(-1);
+    this->_format = false;
+    this->_runsInBackground = false;
+}
+
+LinboJob::ResourceClasses LinboJob::resourceClasses() {
+    switch (this->_type) {
+    case CreateBaseImageJob:
+    case CreateDiffImageJob:
+    case PartitionDriveJob:
+        return DiskResource;
+    case UploadImageJob:
+        // linbo_cmd mounts and unmounts the cache for the upload, it must not run next to another linbo_cmd doing the same
+    case SyncOsJob:
+    case InitCacheJob:
+        return DiskResource | NetworkResource;
+    }
+    return DiskResource | NetworkResource;
+}
+
+bool LinboJob::dependsOn(LinboJob* job) {
+    // An upload needs the image to be created first
+    return this->_type == UploadImageJob &&
+           (job->_type == CreateBaseImageJob || job->_type == CreateDiffImageJob) &&
+           job->imageName() == this->imageName();
+}
+
+QString LinboJob::imageName() {
+    if(!this->_imageName.isEmpty() || this->_os == nullptr || this->_os->baseImage() == nullptr)
+        return this->_imageName;
+
+    QString baseImageName = this->_os->baseImage()->name();
+    if(this->_type == CreateDiffImageJob)
+        return baseImageName.replace(QRegularExpression(".qcow2$"), ".qdiff");
+
+    return baseImageName;
+}
+
+qint64 LinboJob::durationMs() {
+    if(!this->_startedAt.isValid())
+        return 0;
+    if(!this->_finishedAt.isValid())
+        return this->_startedAt.msecsTo(QDateTime::currentDateTime());
+    return this->_startedAt.msecsTo(this->_finishedAt);
+}
+
+QString LinboJob::toString() {
+    QString string = LinboJob::typeToString(this->_type);
+    if(this->_os != nullptr)
+        string += " " + this->_os->name();
+    if(this->_type == UploadImageJob)
+        string += " (" + this->imageName() + ")";
+    return string;
+}
+
+QString LinboJob::typeToString(JobType type) {
+    switch (type) {
+    case CreateBaseImageJob: return "create-base";
+    case CreateDiffImageJob: return "create-diff";
+    case UploadImageJob: return "upload";
+    case SyncOsJob: return "sync";
+    case InitCacheJob: return "initcache";
+    case PartitionDriveJob: return "partition";
+    }
+    return "";
+}
+
+LinboJob::JobType LinboJob::stringToType(const QString& type, bool* ok) {
+    QList<JobType> types = {CreateBaseImageJob, CreateDiffImageJob, UploadImageJob, SyncOsJob, InitCacheJob, PartitionDriveJob};
+    for(JobType t : types) {
+        if(LinboJob::typeToString(t) == type.toLower()) {
+            if(ok != nullptr)
+                *ok = true;
+            return t;
+        }
+    }
+
+    if(ok != nullptr)
+        *ok = false;
+    return CreateBaseImageJob;
+}
+
+QString LinboJob::statusToString(JobStatus status) {
+    switch (status) {
+    case Pending: return "pending";
+    case Running: return "running";
+    case Succeeded: return "succeeded";
+    case Failed: return "failed";
+    case Cancelled: return "cancelled";
+    case Skipped: return "skipped";
+    }
+    return "";
+}
+
+void LinboJob::_setStatus(JobStatus status) {
+    if(this->_status == status)
+        return;
+
+    if(status == Running)
+        this->_startedAt = QDateTime::currentDateTime();
+    else if(this->_status == Running)
+        this->_finishedAt = QDateTime::currentDateTime();
+
+    this->_status = status;
+    emit this->statusChanged(status);
+}
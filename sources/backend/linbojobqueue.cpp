@@ -0,0 +1,263 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbojobqueue.h"
+#include "linbobackend.h"
+
+LinboJobQueue::LinboJobQueue(LinboBackend* backend, LinboLogger* logger) : QObject(backend)
+{
+    this->_backend = backend;
+    this->_logger = logger;
+    this->_running = false;
+    this->_pipelined = false;
+    this->_aborting = false;
+    this->_postProcessActions = LinboPostProcessActions::NoAction;
+}
+
+LinboJob* LinboJobQueue::currentJob() {
+    for(LinboJob* job : this->_jobs)
+        if(job->status() == LinboJob::Running && !job->runsInBackground())
+            return job;
+    return nullptr;
+}
+
+LinboJob* LinboJobQueue::backgroundJob() {
+    for(LinboJob* job : this->_jobs)
+        if(job->status() == LinboJob::Running && job->runsInBackground())
+            return job;
+    return nullptr;
+}
+
+bool LinboJobQueue::hasFailedJobs() {
+    for(LinboJob* job : this->_jobs)
+        if(job->status() == LinboJob::Failed)
+            return true;
+    return false;
+}
+
+bool LinboJobQueue::append(LinboJob* job) {
+    if(job == nullptr || job->status() != LinboJob::Pending)
+        return false;
+
+    job->setParent(this);
+    this->_jobs.append(job);
+    connect(job, &LinboJob::statusChanged, this, [=]() {
+        emit this->jobStatusChanged(job);
+    });
+
+    // A job appended while the queue is running might be able to start right away
+    if(this->_running)
+        this->_startNextJobs();
+
+    return true;
+}
+
+bool LinboJobQueue::clear() {
+    if(this->_running)
+        return false;
+
+    qDeleteAll(this->_jobs);
+    this->_jobs.clear();
+    return true;
+}
+
+void LinboJobQueue::setPostProcessActions(LinboPostProcessActions::Flags postProcessActions) {
+    // Only actions which make sense after the last job
+    this->_postProcessActions = postProcessActions & (
+                                    LinboPostProcessActions::Shutdown |
+                                    LinboPostProcessActions::Reboot |
+                                    LinboPostProcessActions::Logout
+                                );
+}
+
+bool LinboJobQueue::setPipelined(bool pipelined) {
+    if(this->_running)
+        return false;
+    this->_pipelined = pipelined;
+    return true;
+}
+
+bool LinboJobQueue::start() {
+    if(this->_running || this->_backend->state() != LinboBackend::Root)
+        return false;
+
+    int pendingJobs = 0;
+    for(LinboJob* job : this->_jobs)
+        if(job->status() == LinboJob::Pending)
+            pendingJobs++;
+
+    if(pendingJobs == 0)
+        return false;
+
+    this->_logger->info(
+        "Starting job queue with " + QString::number(pendingJobs) + " jobs" +
+        (this->_pipelined ? " (pipelined)" : "")
+    );
+    this->_running = true;
+    this->_aborting = false;
+    emit this->runningChanged(true);
+
+    this->_startNextJobs();
+    return true;
+}
+
+bool LinboJobQueue::abort() {
+    if(!this->_running)
+        return false;
+
+    this->_logger->info("Aborting job queue");
+
+    for(LinboJob* job : this->_runningJobs())
+        job->_setStatus(LinboJob::Cancelled);
+
+    this->_skipPendingJobs();
+    this->_running = false;
+    emit this->runningChanged(false);
+    emit this->finished(false);
+    return true;
+}
+
+// -----------
+// - Helpers -
+// -----------
+
+void LinboJobQueue::_startNextJobs() {
+    if(!this->_aborting) {
+        for(LinboJob* job : this->_jobs) {
+            if(!this->_running)
+                return;
+            if(!this->_pipelined && !this->_runningJobs().isEmpty())
+                break;
+            if(job->status() != LinboJob::Pending || !this->_canStartJob(job))
+                continue;
+
+            // Jobs which are network bound only may overlap with the next disk bound job
+            bool inBackground = this->_pipelined && job->resourceClasses() == LinboJob::NetworkResource;
+            this->_startJob(job, inBackground);
+        }
+    }
+
+    if(!this->_running)
+        return;
+
+    QList<LinboJob*> runningJobs = this->_runningJobs();
+    if(runningJobs.isEmpty()) {
+        // Nothing could be started, so nothing is left which could unblock the pending jobs
+        this->_skipPendingJobs();
+        this->_finish();
+    }
+    else if(this->currentJob() == nullptr) {
+        // Only an upload is left, show it like a regular one
+        this->_backend->_showBackgroundJob(this->backgroundJob());
+    }
+}
+
+bool LinboJobQueue::_startJob(LinboJob* job, bool inBackground) {
+    this->_logger->info(
+        "Starting job " + QString::number(this->_jobs.indexOf(job) + 1) + "/" + QString::number(this->_jobs.length()) +
+        ": " + job->toString() + (inBackground ? " (in background)" : "")
+    );
+
+    job->_runsInBackground = inBackground;
+    job->_setStatus(LinboJob::Running);
+
+    if(this->_backend->_executeJob(job))
+        return true;
+
+    this->_logger->error("Could not start job: " + job->toString());
+    this->_handleJobFinished(job, false);
+    return false;
+}
+
+bool LinboJobQueue::_canStartJob(LinboJob* job) {
+    for(LinboJob* otherJob : this->_jobs) {
+        if(otherJob == job)
+            break;
+
+        if(job->dependsOn(otherJob) && this->_isFinished(otherJob) && otherJob->status() != LinboJob::Succeeded) {
+            this->_logger->error("Skipping " + job->toString() + ", because " + otherJob->toString() + " did not succeed");
+            job->_setStatus(LinboJob::Skipped);
+            return false;
+        }
+
+        // Earlier jobs of the same resource class and jobs this one depends on have to be done first
+        if(!this->_isFinished(otherJob) && (job->dependsOn(otherJob) || (job->resourceClasses() & otherJob->resourceClasses())))
+            return false;
+    }
+
+    for(LinboJob* runningJob : this->_runningJobs())
+        if(runningJob->resourceClasses() & job->resourceClasses())
+            return false;
+
+    return true;
+}
+
+bool LinboJobQueue::_isFinished(LinboJob* job) {
+    return job->status() != LinboJob::Pending && job->status() != LinboJob::Running;
+}
+
+QList<LinboJob*> LinboJobQueue::_runningJobs() {
+    QList<LinboJob*> runningJobs;
+    for(LinboJob* job : this->_jobs)
+        if(job->status() == LinboJob::Running)
+            runningJobs.append(job);
+    return runningJobs;
+}
+
+void LinboJobQueue::_handleJobFinished(LinboJob* job, bool successful) {
+    if(job == nullptr || job->status() != LinboJob::Running)
+        return;
+
+    job->_setStatus(successful ? LinboJob::Succeeded : LinboJob::Failed);
+    this->_logger->_log(
+        "Job " + job->toString() + " " + LinboJob::statusToString(job->status()) +
+        " after " + QString::number(job->durationMs() / 1000) + "s",
+        successful ? LinboLogger::LinboGuiInfo : LinboLogger::LinboGuiError
+    );
+
+    if(!successful && job->failurePolicy() == LinboJob::AbortOnFailure) {
+        // A job which is still running in parallel is allowed to finish
+        this->_aborting = true;
+        this->_skipPendingJobs();
+    }
+
+    this->_startNextJobs();
+}
+
+void LinboJobQueue::_skipPendingJobs() {
+    for(LinboJob* job : this->_jobs)
+        if(job->status() == LinboJob::Pending)
+            job->_setStatus(LinboJob::Skipped);
+}
+
+void LinboJobQueue::_finish() {
+    bool successful = !this->hasFailedJobs();
+    this->_running = false;
+
+    this->_logger->info("Job queue finished " + QString(successful ? "successfully" : "with errors") + ":");
+    for(LinboJob* job : this->_jobs) {
+        this->_logger->info(
+            "  " + job->toString() + ": " + LinboJob::statusToString(job->status()) +
+            " (" + QString::number(job->durationMs() / 1000) + "s)"
+        );
+    }
+
+    emit this->runningChanged(false);
+    emit this->finished(successful);
+    this->_backend->_handleJobQueueFinished(successful);
+}
@@ -0,0 +1,201 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbologarchive.h"
+
+LinboLogArchive::LinboLogArchive(QString cacheDevice, qint64 maxTotalSize, int maxAgeDays)
+{
+    this->_cacheDevice = cacheDevice;
+    this->_bootTime = QDateTime::currentDateTime();
+    this->_segmentIndex = 0;
+    this->_maxTotalSize = maxTotalSize;
+    this->_maxAgeDays = maxAgeDays;
+    this->_compressedBlocksSize = 0;
+}
+
+void LinboLogArchive::append(const QByteArray& data) {
+    this->_pendingData.append(data);
+    if(this->_pendingData.size() >= _blockSize)
+        this->_compressPendingData();
+}
+
+bool LinboLogArchive::sync(bool mountIfNeeded) {
+    this->_compressPendingData();
+    if(this->_compressedBlocks.isEmpty())
+        return true;
+
+    QString mountPoint = LinboCacheMount::acquire(this->_cacheDevice, mountIfNeeded);
+
+    // keep the blocks until the cache is around
+    if(mountPoint.isEmpty())
+        return false;
+
+    QString directory = directoryOf(mountPoint);
+    bool success = this->_writeCompressedBlocks(directory);
+    if(success)
+        this->_prune(directory);
+
+    LinboCacheMount::release(this->_cacheDevice);
+
+    return success;
+}
+
+QString LinboLogArchive::directoryOf(QString mountPoint) {
+    return mountPoint + "/linbo-log";
+}
+
+QList<LinboLogArchive::Segment> LinboLogArchive::segments(QString directory, QDateTime from, QDateTime to) {
+    QList<Segment> segments;
+    QDateTime previousBootTime;
+    QDateTime previousEnd;
+
+    for(const QFileInfo& segmentFile : _segmentFiles(directory)) {
+        QDateTime bootTime = _bootTimeOfSegment(segmentFile);
+
+        // a segment begins where the previous one of the same boot ended
+        Segment segment {
+            segmentFile.absoluteFilePath(),
+            bootTime == previousBootTime ? previousEnd : bootTime,
+            segmentFile.lastModified(),
+            segmentFile.size()
+        };
+
+        previousBootTime = bootTime;
+        previousEnd = segment.end;
+
+        if(from.isValid() && segment.end < from)
+            continue;
+        if(to.isValid() && segment.begin > to)
+            continue;
+
+        segments.append(segment);
+    }
+
+    return segments;
+}
+
+QByteArray LinboLogArchive::readSegment(QString path) {
+    QFile segmentFile(path);
+    if(!segmentFile.open(QIODevice::ReadOnly) || segmentFile.read(_magic.size()) != _magic)
+        return QByteArray();
+
+    QByteArray data;
+    while(!segmentFile.atEnd()) {
+        QByteArray lengthBytes = segmentFile.read(sizeof(quint32));
+        if(lengthBytes.size() != (qsizetype)sizeof(quint32))
+            break;
+
+        quint32 blockLength = qFromBigEndian<quint32>(lengthBytes.constData());
+        QByteArray block = segmentFile.read(blockLength);
+        if(block.size() != (qsizetype)blockLength)
+            break;
+
+        data.append(qUncompress(block));
+    }
+
+    return data;
+}
+
+// -----------
+// - Helpers -
+// -----------
+
+void LinboLogArchive::_compressPendingData() {
+    if(this->_pendingData.isEmpty())
+        return;
+
+    QByteArray block = qCompress(this->_pendingData);
+    this->_pendingData.clear();
+
+    this->_compressedBlocksSize += block.size();
+    this->_compressedBlocks.append(block);
+
+    // never let the archive eat up the RAM when the cache is not available for a long time
+    while(this->_compressedBlocksSize > _maxUnsyncedSize && this->_compressedBlocks.length() > 1)
+        this->_compressedBlocksSize -= this->_compressedBlocks.takeFirst().size();
+}
+
+bool LinboLogArchive::_writeCompressedBlocks(QString directory) {
+    if(!QDir().mkpath(directory))
+        return false;
+
+    QFile segmentFile;
+    while(!this->_compressedBlocks.isEmpty()) {
+        if(!segmentFile.isOpen()) {
+            segmentFile.setFileName(this->_segmentPath(directory));
+            if(!segmentFile.open(QIODevice::WriteOnly | QIODevice::Append))
+                return false;
+            if(segmentFile.size() == 0)
+                segmentFile.write(_magic);
+        }
+
+        const QByteArray& block = this->_compressedBlocks.first();
+        uchar lengthBytes[sizeof(quint32)];
+        qToBigEndian<quint32>(block.size(), lengthBytes);
+        if(segmentFile.write((const char*)lengthBytes, sizeof(quint32)) != (qint64)sizeof(quint32) || segmentFile.write(block) != block.size())
+            return false;
+
+        this->_compressedBlocksSize -= block.size();
+        this->_compressedBlocks.removeFirst();
+
+        if(segmentFile.size() >= _maxSegmentSize) {
+            segmentFile.close();
+            this->_segmentIndex++;
+        }
+    }
+
+    return true;
+}
+
+void LinboLogArchive::_prune(QString directory) {
+    QList<QFileInfo> segmentFiles = _segmentFiles(directory);
+    QString currentSegmentPath = QFileInfo(this->_segmentPath(directory)).absoluteFilePath();
+    QDateTime oldestAllowed = QDateTime::currentDateTime().addDays(-this->_maxAgeDays);
+
+    qint64 totalSize = 0;
+    for(const QFileInfo& segmentFile : segmentFiles)
+        totalSize += segmentFile.size();
+
+    // oldest first
+    for(const QFileInfo& segmentFile : segmentFiles) {
+        if(segmentFile.absoluteFilePath() == currentSegmentPath)
+            break;
+
+        bool tooOld = this->_maxAgeDays > 0 && segmentFile.lastModified() < oldestAllowed;
+        bool tooBig = this->_maxTotalSize > 0 && totalSize > this->_maxTotalSize;
+        if(!tooOld && !tooBig)
+            continue;
+
+        if(QFile::remove(segmentFile.absoluteFilePath()))
+            totalSize -= segmentFile.size();
+    }
+}
+
+QString LinboLogArchive::_segmentPath(QString directory) {
+    return directory + "/linbo-" + this->_bootTime.toString("yyyyMMdd-HHmmss") + "-" + QString::number(this->_segmentIndex).rightJustified(3, '0') + ".log.z";
+}
+
+QList<QFileInfo> LinboLogArchive::_segmentFiles(QString directory) {
+    // the names sort chronologically
+    return QDir(directory).entryInfoList({"linbo-*.log.z"}, QDir::Files, QDir::Name);
+}
+
+QDateTime LinboLogArchive::_bootTimeOfSegment(const QFileInfo& segmentFile) {
+    // linbo-yyyyMMdd-HHmmss-NNN.log.z
+    return QDateTime::fromString(segmentFile.fileName().mid(6, 15), "yyyyMMdd-HHmmss");
+}
@@ -18,9 +18,38 @@
 
 #include "linbologger.h"
 
-LinboLogger::LinboLogger(QString logFilePath, QObject *parent) : QObject(parent)
+#include <limits>
+
+LinboLogger::LinboLogger(QString logFilePath, QObject *parent)
+    : QObject(parent), _logHistory(_logHistoryCapacity), _errorHistory(_errorHistoryCapacity)
 {
+    this->_currentChapterBegin = 0;
+    this->_currentChapterEnd = std::numeric_limits<quint64>::max();
+    this->_currentChapter = 0;
+    this->_currentChapterTitle = "";
+    this->_structuredLogEnabled = false;
+    this->_linboState = -1;
+
     this->_logFilePath = logFilePath;
+    this->_logWriter = new LinboLogWriter(logFilePath, this);
+    this->_logWriter->start(QThread::LowPriority);
+
+    // the console is the slowest sink on linuxfb, keep it quiet by default
+    this->_sinkLogTypes[ConsoleSink] = stringToSinkLogTypes("error,chapter");
+    this->_sinkLogTypes[FileSink] = stringToSinkLogTypes("verbose");
+    this->_sinkLogTypes[HistorySink] = stringToSinkLogTypes("verbose");
+    this->_sinkLogTypes[StructuredSink] = stringToSinkLogTypes("off");
+
+    for(int sink = 0; sink < LogSinkCount; sink++) {
+        QString sinkConfig = qEnvironmentVariable(qPrintable("LINBO_LOG_" + logSinkToString((LinboLogSink)sink).toUpper()));
+        this->_sinkConfiguredByEnvironment[sink] = false;
+        this->_configureSink((LinboLogSink)sink, sinkConfig);
+        this->_sinkConfiguredByEnvironment[sink] = !sinkConfig.isEmpty();
+    }
+
+    QString structuredLogFromEnvironment = qEnvironmentVariable("LINBO_STRUCTURED_LOG").toLower();
+    if(!structuredLogFromEnvironment.isEmpty() && structuredLogFromEnvironment != "0" && structuredLogFromEnvironment != "false")
+        this->_configureSink(StructuredSink, "verbose");
 }
 
 QString LinboLogger::logTypeToString(LinboLogType logType) {
@@ -42,18 +71,132 @@ QString LinboLogger::logTypeToString(LinboLogType logType) {
     }
 }
 
-void LinboLogger::_log(QString logText, LinboLogType logType) {
+LinboLogger::LinboLogTypes LinboLogger::stringToLogTypes(QString logTypes, bool* ok) {
+    LinboLogTypes types;
+    if(ok != nullptr)
+        *ok = true;
+
+    for(const QString& logType : logTypes.toLower().split(",", Qt::SkipEmptyParts)) {
+        QString trimmedLogType = logType.trimmed();
+        if(trimmedLogType == "stdout")
+            types |= StdOut;
+        else if(trimmedLogType == "stderr")
+            types |= StdErr;
+        else if(trimmedLogType == "info")
+            types |= LinboGuiInfo;
+        else if(trimmedLogType == "error")
+            types |= LinboGuiError;
+        else if(trimmedLogType == "chapter")
+            types |= LinboLogChapterBeginning | LinboLogChapterEnd;
+        else if(trimmedLogType == "all")
+            types |= StdOut | StdErr | LinboGuiInfo | LinboGuiError | LinboLogChapterBeginning | LinboLogChapterEnd;
+        else if(ok != nullptr)
+            *ok = false;
+    }
+
+    return types;
+}
+
+QString LinboLogger::logTypesToString(LinboLogTypes logTypes) {
+    QStringList typeNames;
+    if(logTypes.testFlag(StdOut))
+        typeNames.append("stdout");
+    if(logTypes.testFlag(StdErr))
+        typeNames.append("stderr");
+    if(logTypes.testFlag(LinboGuiInfo))
+        typeNames.append("info");
+    if(logTypes.testFlag(LinboGuiError))
+        typeNames.append("error");
+    if(logTypes.testAnyFlags(LinboLogChapterBeginning | LinboLogChapterEnd))
+        typeNames.append("chapter");
+    return typeNames.isEmpty() ? "off" : typeNames.join(",");
+}
+
+LinboLogger::LinboLogTypes LinboLogger::stringToSinkLogTypes(QString sinkConfig, bool* ok) {
+    LinboLogTypes types;
+    QStringList additionalTypes;
+
+    for(const QString& token : sinkConfig.toLower().split(",", Qt::SkipEmptyParts)) {
+        QString trimmedToken = token.trimmed();
+        if(trimmedToken == "verbose")
+            types |= stringToLogTypes("all");
+        else if(trimmedToken == "info")
+            types |= stringToLogTypes("stderr,info,error,chapter");
+        else if(trimmedToken == "error")
+            types |= stringToLogTypes("stderr,error");
+        else if(trimmedToken != "off")
+            additionalTypes.append(trimmedToken);
+    }
+
+    return types | stringToLogTypes(additionalTypes.join(","), ok);
+}
+
+QString LinboLogger::logSinkToString(LinboLogSink sink) {
+    switch (sink) {
+    case ConsoleSink:
+        return "console";
+    case FileSink:
+        return "file";
+    case HistorySink:
+        return "history";
+    case StructuredSink:
+        return "structured";
+    default:
+        return "unknown";
+    }
+}
+
+LinboLogger::LinboLogTypes LinboLogger::sinkLogTypes(LinboLogSink sink) {
+    return this->_sinkLogTypes[sink];
+}
+
+void LinboLogger::_log(QString logText, LinboLogType logType, bool background) {
     if(logText.isEmpty() || logText == "")
         return;
-    qDebug() << qPrintable("[" + this->logTypeToString(logType) + "] " + logText);
 
-    LinboLog latestLog {logText, logType, QDateTime::currentDateTime()};
-    this->_logHistory.append(latestLog);
+    bool toConsole = this->_sinkLogTypes[ConsoleSink].testFlag(logType);
+    bool toFile = this->_sinkLogTypes[FileSink].testFlag(logType);
+
+    QString logLine;
+    if(toConsole || toFile)
+        logLine = "[" + this->logTypeToString(logType) + "] " + logText;
+
+    if(toConsole)
+        qDebug() << qPrintable(logLine);
+
+    if(logType == LinboLogChapterBeginning) {
+        this->_currentChapter++;
+        this->_currentChapterTitle = logText;
+    }
+
+    LinboLog latestLog {logText, logType, QDateTime::currentDateTime(), this->_currentChapter};
+
+    if(this->_sinkLogTypes[HistorySink].testFlag(logType)) {
+        quint64 sequence = this->_logHistory.append(latestLog);
 
-    // TODO: Log error, when this fails
-    this->_writeToLogFile("[" + this->logTypeToString(logType) + "] " + logText);
+        if(logType == LinboLogChapterBeginning) {
+            this->_currentChapterBegin = sequence;
+            this->_currentChapterEnd = std::numeric_limits<quint64>::max();
+        }
+        else if(logType == LinboLogChapterEnd && this->_currentChapterEnd > sequence) {
+            this->_currentChapterEnd = sequence;
+        }
+        else if(logType == StdErr || logType == LinboGuiError) {
+            this->_errorHistory.append(sequence);
+        }
+    }
 
-    emit this->latestLogChanged(latestLog);
+    if(toFile)
+        this->_logWriter->write(logLine);
+    if(this->_sinkLogTypes[StructuredSink].testFlag(logType))
+        this->_logWriter->writeStructured(this->_structuredRecord(latestLog, QDeadlineTimer::current().deadlineNSecs()));
+    if(logType == LinboLogChapterEnd)
+        this->_logWriter->requestFlush();
+
+    if(background)
+        emit this->latestBackgroundLogChanged(latestLog);
+    else
+        emit this->latestLogChanged(latestLog);
 }
 
 void LinboLogger::info(QString logText) {
@@ -80,42 +223,134 @@ void LinboLogger::stdOut(QString logText) {
     this->_log(logText, LinboLogger::StdOut);
 }
 
-bool LinboLogger::_writeToLogFile(QString text) {
-    // write to logfile
-    QFile logfile(this->_logFilePath);
-    if(!logfile.open( QIODevice::WriteOnly | QIODevice::Append ))
-        return false;
+void LinboLogger::backgroundStdErr(QString logText) {
+    this->_log(logText, LinboLogger::StdErr, true);
+}
+
+void LinboLogger::backgroundStdOut(QString logText) {
+    this->_log(logText, LinboLogger::StdOut, true);
+}
+
+void LinboLogger::flush() {
+    this->_logWriter->flush();
+}
+
+void LinboLogger::_enableArchive(LinboLogArchive* archive) {
+    // Everything which was logged so far is not going to pass the writer again,
+    // so seed the archive with what is still in the history.
+    this->_logWriter->flush();
+
+    QByteArray logsSoFar;
+    for(const LinboLog& log : this->_logHistory.all())
+        logsSoFar.append(QString("[" + this->logTypeToString(log.type) + "] " + log.message + "\n").toUtf8());
+    archive->append(logsSoFar);
+
+    this->_logWriter->setArchive(archive);
+}
+
+void LinboLogger::_enableStructuredLog() {
+    if(this->_structuredLogEnabled)
+        return;
+
+    this->_logWriter->setStructuredLogFile(this->_logFilePath + ".bin");
+
+    // The monotonic time of earlier entries is derived from their wall clock time,
+    // the state and command they were logged in are unknown.
+    qint64 monotonicNsNow = QDeadlineTimer::current().deadlineNSecs();
+    QDateTime now = QDateTime::currentDateTime();
+    int linboState = this->_linboState;
+    QString sourceCommand = this->_sourceCommand;
+    this->_linboState = -1;
+    this->_sourceCommand.clear();
 
-    QTextStream logstream( &logfile );
-    logstream << text << "\n";
-    logfile.flush();
-    logfile.close();
-    return true;
+    for(const LinboLog& log : this->_logHistory.all())
+        if(this->_sinkLogTypes[StructuredSink].testFlag(log.type))
+            this->_logWriter->writeStructured(this->_structuredRecord(log, monotonicNsNow - log.time.msecsTo(now) * 1000000));
+
+    this->_linboState = linboState;
+    this->_sourceCommand = sourceCommand;
+    this->_structuredLogEnabled = true;
+}
+
+void LinboLogger::_configureSink(LinboLogSink sink, QString sinkConfig) {
+    if(sinkConfig.isEmpty() || this->_sinkConfiguredByEnvironment[sink])
+        return;
+
+    bool ok = true;
+    LinboLogTypes logTypes = stringToSinkLogTypes(sinkConfig, &ok);
+    if(!ok) {
+        this->error("Invalid configuration for the " + logSinkToString(sink) + " log sink: " + sinkConfig);
+        return;
+    }
+
+    this->_setSinkLogTypes(sink, logTypes);
+}
+
+void LinboLogger::_setSinkLogTypes(LinboLogSink sink, LinboLogTypes logTypes) {
+    if(sink == HistorySink) {
+        // chapters are looked up in the history
+        logTypes |= LinboLogChapterBeginning | LinboLogChapterEnd;
+    }
+
+    this->_sinkLogTypes[sink] = logTypes;
+
+    if(sink == StructuredSink && logTypes != LinboLogTypes())
+        this->_enableStructuredLog();
+}
+
+void LinboLogger::_setLinboState(int state) {
+    this->_linboState = state;
+}
+
+void LinboLogger::_setSourceCommand(QString command) {
+    this->_sourceCommand = command;
+}
+
+QByteArray LinboLogger::_structuredRecord(const LinboLog& log, qint64 monotonicNs) {
+    QByteArray command = this->_sourceCommand.toUtf8();
+    QByteArray message = log.message.toUtf8();
+
+    LinboStructuredLog::RecordHeader header {
+        monotonicNs,
+        log.time.toMSecsSinceEpoch(),
+        (qint8)log.type,
+        (qint8)this->_linboState,
+        log.chapter,
+        (quint16)command.size(),
+        (quint32)message.size()
+    };
+
+    return LinboStructuredLog::encode(header, command, message);
 }
 
 const LinboLogger::LinboLog& LinboLogger::getLatestLog() {
     return this->_logHistory.last();
 }
 
-QList<LinboLogger::LinboLog> LinboLogger::logs() {
-    return this->_logHistory;
+LinboLogger::LinboLogView LinboLogger::logs() {
+    return this->_logHistory.all();
 }
 
-QList<LinboLogger::LinboLog> LinboLogger::logsOfCurrentChapter() {
-    QList<LinboLog> tmpLogs;
+LinboLogger::LinboLogView LinboLogger::logsOfCurrentChapter() {
+    // The chapter end itself is not part of the chapter
+    return this->_logHistory.view(this->_currentChapterBegin, this->_currentChapterEnd);
+}
 
-    for(int i = this->_logHistory.length() - 1; i >= 0; i--) {
-        tmpLogs.append(this->_logHistory[i]);
-        if(this->_logHistory[i].type == LinboLogType::LinboLogChapterBeginning)
-            break;
-        else if(this->_logHistory[i].type == LinboLogType::LinboLogChapterEnd)
-            tmpLogs.clear();
-    }
+QString LinboLogger::currentChapterTitle() {
+    return this->_currentChapterTitle;
+}
 
-    return tmpLogs;
+QList<LinboLogger::LinboLog> LinboLogger::latestErrors(int count) {
+    QList<LinboLog> errors;
+    LinboRingBuffer<quint64>::View errorSequences = this->_errorHistory.all();
+    for(qsizetype i = errorSequences.size() - 1; i >= 0 && errors.length() < count; i--) {
+        if(this->_logHistory.contains(errorSequences[i]))
+            errors.prepend(this->_logHistory.at(errorSequences[i]));
+    }
+    return errors;
 }
 
-QList<LinboLogger::LinboLog> LinboLogger::filteredLogs(QList<LinboLog> logs, LinboLogTypes filterTypes) {
+QList<LinboLogger::LinboLog> LinboLogger::filteredLogs(const LinboLogView& logs, LinboLogTypes filterTypes) {
     QList<LinboLog> tmpLogs;
 
     for(const LinboLog &log : logs) {
@@ -126,10 +361,10 @@ QList<LinboLogger::LinboLog> LinboLogger::filteredLogs(QList<LinboLog> logs, Lin
     return tmpLogs;
 }
 
-
-QStringList LinboLogger::logsToStacktrace(QList<LinboLog> logs, int limit) {
+QStringList LinboLogger::logsToStacktrace(const LinboLogView& logs, int limit) {
+    // newest first
     QStringList logStrings;
-    for(int i = 0; i < logs.length(); i++) {
+    for(qsizetype i = logs.length() - 1; i >= 0; i--) {
         if(logStrings.length() >= limit && limit > 0)
             break;
 
@@ -0,0 +1,172 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbologwriter.h"
+
+LinboLogWriter::LinboLogWriter(QString logFilePath, QObject *parent) : QThread(parent)
+{
+    this->_logFilePath = logFilePath;
+    this->_archive = nullptr;
+    this->_flushRequested = false;
+    this->_stopRequested = false;
+    this->_flushRequestCount = 0;
+    this->_flushCount = 0;
+}
+
+LinboLogWriter::~LinboLogWriter() {
+    this->_mutex.lock();
+    this->_stopRequested = true;
+    this->_wakeCondition.wakeOne();
+    this->_mutex.unlock();
+
+    this->wait();
+
+    delete this->_archive;
+}
+
+void LinboLogWriter::setArchive(LinboLogArchive* archive) {
+    QMutexLocker locker(&this->_mutex);
+    if(this->_archive != nullptr) {
+        delete archive;
+        return;
+    }
+
+    this->_archive = archive;
+}
+
+void LinboLogWriter::setStructuredLogFile(QString structuredLogFilePath) {
+    QMutexLocker locker(&this->_mutex);
+    this->_structuredLogFilePath = structuredLogFilePath;
+}
+
+void LinboLogWriter::write(const QString& line) {
+    QMutexLocker locker(&this->_mutex);
+    bool queuesWereEmpty = this->_queue.isEmpty() && this->_structuredQueue.isEmpty();
+
+    this->_queue.append(line.toUtf8());
+    this->_queue.append('\n');
+
+    this->_wakeForNewData(queuesWereEmpty);
+}
+
+void LinboLogWriter::writeStructured(const QByteArray& record) {
+    QMutexLocker locker(&this->_mutex);
+    bool queuesWereEmpty = this->_queue.isEmpty() && this->_structuredQueue.isEmpty();
+
+    this->_structuredQueue.append(record);
+
+    this->_wakeForNewData(queuesWereEmpty);
+}
+
+void LinboLogWriter::requestFlush() {
+    QMutexLocker locker(&this->_mutex);
+    this->_flushRequestCount++;
+    this->_flushRequested = true;
+    this->_wakeCondition.wakeOne();
+}
+
+void LinboLogWriter::flush() {
+    QMutexLocker locker(&this->_mutex);
+    if(!this->isRunning())
+        return;
+
+    quint64 flushTicket = ++this->_flushRequestCount;
+    this->_flushRequested = true;
+    this->_wakeCondition.wakeOne();
+
+    // Don't hang forever in case the disk is stuck, shutdown has to go on.
+    QDeadlineTimer deadline(5000);
+    while(this->_flushCount < flushTicket && !deadline.hasExpired()) {
+        if(!this->_flushedCondition.wait(&this->_mutex, deadline))
+            break;
+    }
+}
+
+void LinboLogWriter::run() {
+    QFile logFile(this->_logFilePath);
+    logFile.open(QIODevice::WriteOnly | QIODevice::Append);
+    QFile structuredLogFile;
+
+    QMutexLocker locker(&this->_mutex);
+    forever {
+        if(this->_queue.isEmpty() && this->_structuredQueue.isEmpty() && !this->_flushRequested && !this->_stopRequested)
+            this->_wakeCondition.wait(&this->_mutex);
+
+        // give the batch some time to fill up, unless somebody is waiting for it
+        if(!this->_flushRequested && !this->_stopRequested && this->_queue.size() + this->_structuredQueue.size() < _flushSizeThreshold)
+            this->_wakeCondition.wait(&this->_mutex, _flushIntervalMs);
+
+        QByteArray batch;
+        batch.swap(this->_queue);
+        QByteArray structuredBatch;
+        structuredBatch.swap(this->_structuredQueue);
+        if(structuredLogFile.fileName().isEmpty())
+            structuredLogFile.setFileName(this->_structuredLogFilePath);
+        quint64 flushTicket = this->_flushRequestCount;
+        bool flushRequested = this->_flushRequested;
+        bool stopRequested = this->_stopRequested;
+        LinboLogArchive* archive = this->_archive;
+        this->_flushRequested = false;
+
+        locker.unlock();
+        this->_writeBatch(logFile, batch);
+        this->_writeBatch(structuredLogFile, structuredBatch, LinboStructuredLog::fileMagic());
+        locker.relock();
+
+        // flush() only waits for the log files, not for the archive
+        this->_flushCount = flushTicket;
+        this->_flushedCondition.wakeAll();
+
+        if(archive != nullptr) {
+            locker.unlock();
+            archive->append(batch);
+            // never mounts the cache, linbo_cmd might be about to mount it itself (eg. to start an os)
+            if(flushRequested || stopRequested)
+                archive->sync(false);
+            locker.relock();
+        }
+
+        if(stopRequested)
+            break;
+    }
+
+    logFile.close();
+    structuredLogFile.close();
+}
+
+void LinboLogWriter::_wakeForNewData(bool queuesWereEmpty) {
+    // Wake the writer when a new batch starts (to arm the flush interval)
+    // or when the batch got big enough to be written right away.
+    if(queuesWereEmpty || this->_queue.size() + this->_structuredQueue.size() >= _flushSizeThreshold)
+        this->_wakeCondition.wakeOne();
+}
+
+void LinboLogWriter::_writeBatch(QFile& logFile, const QByteArray& batch, const QByteArray& header) {
+    if(batch.isEmpty() || logFile.fileName().isEmpty())
+        return;
+
+    // the file might not have been writable when we started (eg. /tmp not mounted yet)
+    if(!logFile.isOpen() && !logFile.open(QIODevice::WriteOnly | QIODevice::Append))
+        return;
+
+    if(logFile.size() == 0)
+        logFile.write(header);
+
+    logFile.write(batch);
+    logFile.flush();
+}
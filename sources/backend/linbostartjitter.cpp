@@ -0,0 +1,51 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbostartjitter.h"
+
+int LinboStartJitter::delayMilliseconds(const QString& macAddress, int jitterSeconds, int windowSeconds) {
+    if(jitterSeconds <= 0 || macAddress.isEmpty())
+        return 0;
+
+    qint64 jitterMilliseconds = qint64(jitterSeconds) * 1000;
+    qint64 delay = _hash(macAddress) % jitterMilliseconds;
+
+    if(windowSeconds > 0) {
+        qint64 windowMilliseconds = qint64(windowSeconds) * 1000;
+        delay = delay / windowMilliseconds * windowMilliseconds;
+    }
+
+    return int(delay);
+}
+
+quint32 LinboStartJitter::_hash(const QString& macAddress) {
+    // FNV-1a over the hex digits only, so "AA:BB:.." and "aa-bb-.." give the same delay
+    quint32 hash = 2166136261u;
+    for(const QChar& character : macAddress.toLower()) {
+        if(!character.isLetterOrNumber())
+            continue;
+        hash ^= quint32(character.unicode());
+        hash *= 16777619u;
+    }
+
+    // the last bytes of MACs in a room are often sequential, mix them into the upper bits as well
+    hash ^= hash >> 15;
+    hash *= 0x2c1b3c6du;
+    hash ^= hash >> 12;
+    return hash;
+}
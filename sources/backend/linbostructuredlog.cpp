@@ -0,0 +1,107 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbostructuredlog.h"
+
+QByteArray LinboStructuredLog::encode(const RecordHeader& header, const QByteArray& command, const QByteArray& message) {
+    QByteArray record(headerSize + command.size() + message.size(), Qt::Uninitialized);
+    uchar* data = reinterpret_cast<uchar*>(record.data());
+
+    qToLittleEndian<qint64>(header.monotonicNs, data);
+    qToLittleEndian<qint64>(header.wallClockMs, data + 8);
+    data[16] = (uchar)header.type;
+    data[17] = (uchar)header.state;
+    qToLittleEndian<quint32>(header.chapter, data + 18);
+    qToLittleEndian<quint16>(command.size(), data + 22);
+    qToLittleEndian<quint32>(message.size(), data + 24);
+
+    memcpy(data + headerSize, command.constData(), command.size());
+    memcpy(data + headerSize + command.size(), message.constData(), message.size());
+
+    return record;
+}
+
+// ----------
+// - Reader -
+// ----------
+
+LinboStructuredLog::Reader::Reader(QString path) : _file(path)
+{
+    this->_data = nullptr;
+    this->_size = 0;
+    this->_position = 0;
+}
+
+LinboStructuredLog::Reader::~Reader() {
+    if(this->_data != nullptr)
+        this->_file.unmap(const_cast<uchar*>(this->_data));
+}
+
+bool LinboStructuredLog::Reader::open() {
+    if(!this->_file.open(QIODevice::ReadOnly))
+        return false;
+
+    this->_size = this->_file.size();
+    if(this->_size < _magic.size())
+        return false;
+
+    this->_data = this->_file.map(0, this->_size);
+    if(this->_data == nullptr || memcmp(this->_data, _magic.constData(), _magic.size()) != 0)
+        return false;
+
+    this->_position = _magic.size();
+    return true;
+}
+
+bool LinboStructuredLog::Reader::atEnd() const {
+    return this->_data == nullptr || this->_position + headerSize > this->_size;
+}
+
+bool LinboStructuredLog::Reader::readHeader(RecordHeader* header) {
+    if(this->atEnd())
+        return false;
+
+    const uchar* data = this->_data + this->_position;
+    header->monotonicNs = qFromLittleEndian<qint64>(data);
+    header->wallClockMs = qFromLittleEndian<qint64>(data + 8);
+    header->type = (qint8)data[16];
+    header->state = (qint8)data[17];
+    header->chapter = qFromLittleEndian<quint32>(data + 18);
+    header->commandLength = qFromLittleEndian<quint16>(data + 22);
+    header->messageLength = qFromLittleEndian<quint32>(data + 24);
+
+    // the last record might be truncated
+    if(this->_position + headerSize + header->commandLength + header->messageLength > this->_size) {
+        this->_position = this->_size;
+        return false;
+    }
+
+    this->_position += headerSize;
+    return true;
+}
+
+void LinboStructuredLog::Reader::readStrings(const RecordHeader& header, QString* command, QString* message) {
+    const char* data = reinterpret_cast<const char*>(this->_data + this->_position);
+    *command = QString::fromUtf8(data, header.commandLength);
+    *message = QString::fromUtf8(data + header.commandLength, header.messageLength);
+    this->skipStrings(header);
+}
+
+void LinboStructuredLog::Reader::skipStrings(const RecordHeader& header) {
+    this->_position += header.commandLength + header.messageLength;
+}
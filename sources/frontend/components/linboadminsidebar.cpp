@@ -26,7 +26,6 @@ LinboAdminSidebarItem::LinboAdminSidebarItem(const QString& label, LinboTheme::I
     : QWidget(parent),
     _label(label),
     _iconEnum(icon),
-    _iconCacheSize(0),
     _expandWidth(0),
     _fullExpandedWidth(200),
     _collapsedWidth(60),
@@ -44,9 +43,8 @@ LinboAdminSidebarItem::LinboAdminSidebarItem(const QString& label, LinboTheme::I
     // Extract first word as short label
     _shortLabel = _label.split(' ').first();
 
-    // Load SVG renderer
-    QString iconPath = gTheme->iconPath(_iconEnum);
-    _svgRenderer = new QSvgRenderer(iconPath, this);
+    // rasterized by the svg cache, for each of the two sizes used below
+    _iconPath = gTheme->iconPath(_iconEnum);
 
     _expandAnimation = new QPropertyAnimation(this, "expandWidth");
     _expandAnimation->setDuration(200);
@@ -68,18 +66,6 @@ void LinboAdminSidebarItem::setItemDisabled(bool disabled) {
     update();
 }
 
-void LinboAdminSidebarItem::_ensureIconCache(int size) {
-    if(size <= 0) return;
-    if(_iconCacheSize == size) return;
-
-    _iconCache = QPixmap(size, size);
-    _iconCache.fill(Qt::transparent);
-    QPainter p(&_iconCache);
-    p.setRenderHint(QPainter::Antialiasing);
-    _svgRenderer->render(&p, QRectF(0, 0, size, size));
-    _iconCacheSize = size;
-}
-
 void LinboAdminSidebarItem::paintEvent(QPaintEvent* event) {
     Q_UNUSED(event)
     QPainter p(this);
@@ -88,7 +74,6 @@ void LinboAdminSidebarItem::paintEvent(QPaintEvent* event) {
     int h = this->height();
     int collW = _collapsedWidth;
     int iconSize = qMax(1, (int)(h * 0.65));
-    _ensureIconCache(iconSize);
 
     qreal opacity = _isItemDisabled ? 0.3 : 1.0;
     p.setOpacity(opacity);
@@ -123,11 +108,9 @@ void LinboAdminSidebarItem::paintEvent(QPaintEvent* event) {
 
         // Icon right, centered in the collapsed strip area
         int iconPillSize = qMax(1, pillH * 50 / 100);
-        _ensureIconCache(iconPillSize);
         int iconX = this->width() - collW / 2 - iconPillSize / 2;
         int iconY = (h - iconPillSize) / 2;
-        if(!_iconCache.isNull())
-            p.drawPixmap(iconX, iconY, _iconCache);
+        LinboSvgCache::paint(&p, QRectF(iconX, iconY, iconPillSize, iconPillSize), _iconPath);
 
         // Label text left of icon
         QFont font;
@@ -166,8 +149,7 @@ void LinboAdminSidebarItem::paintEvent(QPaintEvent* event) {
         int startY = (h - totalH) / 2;
 
         int iconY = startY;
-        if(!_iconCache.isNull())
-            p.drawPixmap(iconX, iconY, _iconCache);
+        LinboSvgCache::paint(&p, QRectF(iconX, iconY, iconSize, iconSize), _iconPath);
 
         p.setFont(labelFont);
         p.setPen(gTheme->textAt(120));
@@ -281,12 +263,17 @@ LinboAdminSidebar::LinboAdminSidebar(LinboBackend* backend, QWidget* parent)
 
     bool hasOs = _backend->config()->operatingSystems().length() > 0;
 
-    // Create 4 items with same translation IDs as LinboMainActions
+    // Create items with same translation IDs as LinboMainActions
     //% "Open terminal"
     auto* terminalItem = new LinboAdminSidebarItem(qtTrId("main_root_button_openTerminal"), LinboTheme::TerminalIcon, this);
     connect(terminalItem, &LinboAdminSidebarItem::clicked, this, &LinboAdminSidebar::terminalRequested);
     _items.append(terminalItem);
 
+    //% "Show logs"
+    auto* logItem = new LinboAdminSidebarItem(qtTrId("main_root_button_showLogs"), LinboTheme::LogIcon, this);
+    connect(logItem, &LinboAdminSidebarItem::clicked, this, &LinboAdminSidebar::logViewerRequested);
+    _items.append(logItem);
+
     //% "Update cache"
     _cacheItem = new LinboAdminSidebarItem(qtTrId("main_root_button_updateCache"), LinboTheme::SyncIcon, this);
     _cacheItem->setVisible(hasOs);
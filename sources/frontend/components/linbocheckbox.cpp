@@ -20,31 +20,69 @@
 
 LinboCheckBox::LinboCheckBox(QString label, QWidget* parent) : QCheckBox(label, parent)
 {
+    // painted directly, a stylesheet would be re-polished on every paint
+    this->_textColor = gTheme->color(LinboTheme::TextColor);
+    this->_disabledTextColor = this->_textColor;
+    this->_disabledTextColor.setAlpha(100);
+    this->_accentColor = gTheme->color(LinboTheme::AccentColor);
+}
+
+QSize LinboCheckBox::sizeHint() const {
+    QFontMetrics metrics(this->font());
+    int indicatorSize = this->_indicatorSize();
+    return QSize(
+        indicatorSize + _spacing + metrics.horizontalAdvance(this->text()) + 2 * _focusMargin,
+        qMax(indicatorSize, metrics.height()) + 2 * _focusMargin
+    );
 }
 
 void LinboCheckBox::paintEvent(QPaintEvent *e) {
-    QString indicatorSize = QString::number(this->font().pixelSize());
-    this->setStyleSheet(
-        gTheme->insertValues(
-            QString(
-                "QCheckBox {"
-                "    color: %TextColor;"
-                "    spacing: 6px;"
-                "}"
-                "QCheckBox::indicator {"
-                "    width: %1px;"
-                "    height: %1px;"
-                "}"
-                "QCheckBox::indicator:unchecked {"
-                "    image: url(%CheckBoxUncheckedIcon);"
-                "}"
-                "QCheckBox::indicator:checked {"
-                "    image: url(%CheckBoxCheckedIcon);"
-                "}"
-            )
-            .arg(
-                indicatorSize
-            )));
-
-    QCheckBox::paintEvent(e);
+    Q_UNUSED(e)
+
+    int indicatorSize = this->_indicatorSize();
+    QRect contentRect = this->rect().adjusted(_focusMargin, _focusMargin, -_focusMargin, -_focusMargin);
+    QPainter painter(this);
+
+    if(!this->isEnabled())
+        painter.setOpacity(0.4);
+    painter.drawPixmap(
+        QRect(contentRect.left(), contentRect.top() + (contentRect.height() - indicatorSize) / 2, indicatorSize, indicatorSize),
+        this->_indicatorPixmap(this->isChecked(), indicatorSize)
+    );
+    painter.setOpacity(1);
+
+    painter.setFont(this->font());
+    painter.setPen(this->isEnabled() ? this->_textColor : this->_disabledTextColor);
+    painter.drawText(contentRect.adjusted(indicatorSize + _spacing, 0, 0, 0), Qt::AlignLeft | Qt::AlignVCenter, this->text());
+
+    if(this->_showsFocus()) {
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(this->_accentColor, 1));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRoundedRect(QRectF(this->rect()).adjusted(0.5, 0.5, -0.5, -0.5), 4, 4);
+    }
+}
+
+bool LinboCheckBox::hitButton(const QPoint &pos) const {
+    return this->rect().contains(pos);
+}
+
+int LinboCheckBox::_indicatorSize() const {
+    return std::max(10, this->font().pixelSize());
+}
+
+bool LinboCheckBox::_showsFocus() const {
+    // like the qt styles, only when the focus was moved with the keyboard
+    return this->hasFocus() && this->window()->testAttribute(Qt::WA_KeyboardFocusChange);
+}
+
+QPixmap LinboCheckBox::_indicatorPixmap(bool checked, int size) {
+    // cached per state and size by the svg cache
+    return LinboSvgCache::pixmap(
+        gTheme->iconPath(checked ? LinboTheme::CheckBoxCheckedIcon : LinboTheme::CheckBoxUncheckedIcon),
+        QSize(size, size),
+        QColor(),
+        Qt::IgnoreAspectRatio,
+        this->devicePixelRatioF()
+    );
 }
@@ -23,6 +23,7 @@ LinboDialog::LinboDialog(QWidget* parent) : QWidget(parent)
 {
     this->_busy = false;
     this->_firstChild = nullptr;
+    this->_tabOrderOutdated = true;
     this->setWindowFlags(Qt::Widget);
     this->raise();
     this->setVisible(false);
@@ -73,6 +74,9 @@ void LinboDialog::_initToolbar() {
     this->_closeButton = new LinboToolButton(LinboTheme::CancelIcon);
     connect(this->_closeButton, &LinboToolButton::clicked, this, &LinboDialog::autoClose);
     connect(this->_closeButton, &LinboToolButton::clicked, this, &LinboDialog::closedByUser);
+    // This is a hack to create a cricle for tabbing inside a dialog
+    // This does not work for the first child, though. So there is still a hole in the circle
+    connect(this->_closeButton, &LinboPushButton::defocused, this, &LinboDialog::_handleCloseButtonDefocused);
 
     this->_toolBarWidget = new QWidget(this->parentWidget());
     this->_toolBarWidget->setAutoFillBackground(true);
@@ -120,7 +124,7 @@ void LinboDialog::autoClose() {
 void LinboDialog::addToolButton(LinboToolButton* toolButton) {
     this->_toolButtons.append(toolButton);
     this->_bottomToolBarLayout->addWidget(toolButton);
-    this->repaint();
+    this->_invalidateTabOrder();
 }
 
 void LinboDialog::setTitle(QString title) {
@@ -174,7 +178,8 @@ void LinboDialog::_resizeBottomToolBar(int rowHeight, int margins, int toolBarHe
 }
 
 void LinboDialog::paintEvent(QPaintEvent *e) {
-    this->_updateTabOrder();
+    if(this->_tabOrderOutdated)
+        this->_updateTabOrder();
 
     // Explicit solid background (linuxfb palette rendering unreliable)
     QPainter painter(this);
@@ -189,11 +194,36 @@ void LinboDialog::paintEvent(QPaintEvent *e) {
     Q_UNUSED(e)
 }
 
+void LinboDialog::childEvent(QChildEvent *e) {
+    // a child shown or hidden changes the tab order as well
+    if(e->added() && e->child()->isWidgetType())
+        e->child()->installEventFilter(this);
+
+    if(e->added() || e->removed())
+        this->_invalidateTabOrder();
+
+    QWidget::childEvent(e);
+}
+
+bool LinboDialog::eventFilter(QObject *watched, QEvent *e) {
+    if(e->type() == QEvent::ShowToParent || e->type() == QEvent::HideToParent)
+        this->_invalidateTabOrder();
+
+    return QWidget::eventFilter(watched, e);
+}
+
+void LinboDialog::_invalidateTabOrder() {
+    // rebuilt with the next paint, so a burst of changes only costs one rebuild
+    this->_tabOrderOutdated = true;
+    this->update();
+}
+
 void LinboDialog::_updateTabOrder() {
     WidgetPair pair{nullptr, nullptr};
     pair = this->_updateTabOrderChildren(pair);
     pair = this->_updateTabOrderBottomToolBar(pair);
-    this->_closeTabOrderCircle(pair);
+    this->_lastChild = pair.second;
+    this->_tabOrderOutdated = false;
 }
 
 LinboDialog::WidgetPair LinboDialog::_updateTabOrderChildren(WidgetPair currentPair) {
@@ -221,19 +251,15 @@ LinboDialog::WidgetPair LinboDialog::_updateTabOrderBottomToolBar(WidgetPair cur
     return currentPair;
 }
 
-void LinboDialog::_closeTabOrderCircle(WidgetPair currentPair) {
-    // This is a hack to create a cricle for tabbing inside a dialog
-    // This does not work for the first child, though. So there is still a hole in the circle
-    connect(this->_closeButton, &LinboPushButton::defocused, this, [=](Qt::FocusReason reason) {
-        if(reason == Qt::TabFocusReason)
-            currentPair.first->setFocus();
-        else if(reason == Qt::BacktabFocusReason)
-            currentPair.second->setFocus();
-    });
+void LinboDialog::_handleCloseButtonDefocused(Qt::FocusReason reason) {
+    if(reason == Qt::TabFocusReason && this->_firstChild != nullptr)
+        this->_firstChild->setFocus();
+    else if(reason == Qt::BacktabFocusReason && this->_lastChild != nullptr)
+        this->_lastChild->setFocus();
 }
 
 LinboDialog::WidgetPair LinboDialog::_updateWidgetTabOrder(QWidget* widget, WidgetPair currentPair) {
-    if(widget->focusPolicy() == Qt::NoFocus)
+    if(widget->focusPolicy() == Qt::NoFocus || widget->isHidden())
         return currentPair;
 
     if(currentPair.second != nullptr)
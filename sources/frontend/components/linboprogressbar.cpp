@@ -26,6 +26,9 @@ LinboProgressBar::LinboProgressBar(QWidget* parent) : QProgressBar(parent)
     this->_indeterminateAnimtion->setEndValue(1000);
     this->_indeterminateAnimtion->setEasingCurve(QEasingCurve(QEasingCurve::InOutQuad));
     this->_indeterminateAnimtion->setLoopCount(-1);
+    // loops forever, but only while the bar can be seen
+    if(gIdleGovernor != nullptr)
+        gIdleGovernor->bindAnimation(this->_indeterminateAnimtion, this);
 
     this->setValue(0);
 }
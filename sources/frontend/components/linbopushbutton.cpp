@@ -47,7 +47,7 @@ LinboPushButton::LinboPushButton(QString icon, QString label, QList<LinboPushBut
     this->_label = new QLabel(label, this);
     this->_label->setAlignment(Qt::AlignCenter);
     if(!icon.isEmpty()) {
-        this->_svgIcon = new QSvgWidget(icon);
+        this->_svgIcon = new LinboSvgWidget(icon);
     }
 
     this->_initOverlays(extraOverlays);
@@ -81,9 +81,10 @@ void LinboPushButton::_initOverlays(QList<LinboPushButtonOverlay*> extraOverlays
 }
 
 LinboPushButton::OverlayList LinboPushButton::_createDefaultOverlays() {
-    this->_hoveredOverlay = new QSvgWidget(gTheme->iconPath(LinboTheme::OverlayHoveredIcon));
-    QSvgWidget* pressedOverlay = new QSvgWidget(gTheme->iconPath(LinboTheme::OverlayPressedIcon));
-    QSvgWidget* keyboardFocusOverlay = new QSvgWidget(gTheme->iconPath(LinboTheme::OverlayKeyboardFocusIcon));
+    // the overlays are the same for every button, so they share their pixmaps
+    this->_hoveredOverlay = new LinboSvgWidget(gTheme->iconPath(LinboTheme::OverlayHoveredIcon));
+    LinboSvgWidget* pressedOverlay = new LinboSvgWidget(gTheme->iconPath(LinboTheme::OverlayPressedIcon));
+    LinboSvgWidget* keyboardFocusOverlay = new LinboSvgWidget(gTheme->iconPath(LinboTheme::OverlayKeyboardFocusIcon));
     QList<QPair<LinboPushButtonOverlay::OverlayType, QWidget*>> defaultOverlayWidgets =
     {
         {LinboPushButtonOverlay::Background, this->_svgIcon},
@@ -262,7 +263,7 @@ void LinboPushButton::setOverlayTypeMuted(LinboPushButtonOverlay::OverlayType ov
     else if(!this->_mutedOverlayTypes.contains(overlayType) && muted)
         this->_mutedOverlayTypes.append(overlayType);
 
-    this->repaint();
+    this->update();
 }
 
 void LinboPushButton::paintEvent(QPaintEvent *e) {
@@ -18,39 +18,92 @@
 
 #include "linboradiobutton.h"
 
+QHash<QString, QPixmap> LinboRadioButton::_indicatorCache;
+
 LinboRadioButton::LinboRadioButton(QString label, QWidget* parent) : QRadioButton(label, parent)
 {
+    // painted directly, a stylesheet would be re-polished on every paint
+    this->_textColor = QColor("#fafafa");
+    this->_disabledTextColor = this->_textColor;
+    this->_disabledTextColor.setAlpha(100);
+    this->_accentColor = gTheme->color(LinboTheme::AccentColor);
+}
 
+QSize LinboRadioButton::sizeHint() const {
+    QFontMetrics metrics(this->font());
+    int indicatorSize = this->_indicatorSize();
+    return QSize(
+        indicatorSize + _spacing + metrics.horizontalAdvance(this->text()) + 2 * _focusMargin,
+        qMax(indicatorSize, metrics.height()) + 2 * _focusMargin
+    );
 }
 
 void LinboRadioButton::paintEvent(QPaintEvent *e) {
-    int sz = std::max(10, this->font().pixelSize());
-    this->setStyleSheet(
-        QString(
-            "QRadioButton {"
-            "    color: #fafafa;"
-            "    spacing: 6px;"
-            "}"
-            "QRadioButton::indicator {"
-            "    width: %1px;"
-            "    height: %1px;"
-            "    border-radius: %2px;"
-            "    border: 2px solid rgba(255,255,255,40);"
-            "    background: transparent;"
-            "}"
-            "QRadioButton::indicator:checked {"
-            "    border: 2px solid #0081c6;"
-            "    background: qradialgradient(cx:0.5, cy:0.5, radius:0.35,"
-            "                fx:0.5, fy:0.5,"
-            "                stop:0 #0081c6, stop:1 #0081c6);"
-            "}"
-            "QRadioButton::indicator:disabled {"
-            "    border: 2px solid rgba(255,255,255,20);"
-            "    background: rgba(255,255,255,5);"
-            "}"
-        )
-        .arg(sz)
-        .arg(sz / 2));
-
-    QRadioButton::paintEvent(e);
+    Q_UNUSED(e)
+
+    int indicatorSize = this->_indicatorSize();
+    QRect contentRect = this->rect().adjusted(_focusMargin, _focusMargin, -_focusMargin, -_focusMargin);
+    QPainter painter(this);
+
+    painter.drawPixmap(
+        QRect(contentRect.left(), contentRect.top() + (contentRect.height() - indicatorSize) / 2, indicatorSize, indicatorSize),
+        this->_indicatorPixmap(this->isChecked(), this->isEnabled(), indicatorSize)
+    );
+
+    painter.setFont(this->font());
+    painter.setPen(this->isEnabled() ? this->_textColor : this->_disabledTextColor);
+    painter.drawText(contentRect.adjusted(indicatorSize + _spacing, 0, 0, 0), Qt::AlignLeft | Qt::AlignVCenter, this->text());
+
+    if(this->_showsFocus()) {
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(this->_accentColor, 1));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRoundedRect(QRectF(this->rect()).adjusted(0.5, 0.5, -0.5, -0.5), 4, 4);
+    }
+}
+
+bool LinboRadioButton::hitButton(const QPoint &pos) const {
+    return this->rect().contains(pos);
+}
+
+int LinboRadioButton::_indicatorSize() const {
+    return std::max(10, this->font().pixelSize());
+}
+
+bool LinboRadioButton::_showsFocus() const {
+    // like the qt styles, only when the focus was moved with the keyboard
+    return this->hasFocus() && this->window()->testAttribute(Qt::WA_KeyboardFocusChange);
+}
+
+QPixmap LinboRadioButton::_indicatorPixmap(bool checked, bool enabled, int size) {
+    qreal devicePixelRatio = this->devicePixelRatioF();
+    QString key = QString("%1-%2-%3-%4").arg(checked).arg(enabled).arg(size).arg(devicePixelRatio);
+    if(_indicatorCache.contains(key))
+        return _indicatorCache.value(key);
+
+    QPixmap pixmap(QSize(size, size) * devicePixelRatio);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QColor borderColor(255, 255, 255, 40);
+    QColor fillColor = Qt::transparent;
+    if(!enabled) {
+        borderColor = QColor(255, 255, 255, 20);
+        fillColor = QColor(255, 255, 255, 5);
+    }
+    else if(checked) {
+        borderColor = this->_accentColor;
+        fillColor = this->_accentColor;
+    }
+
+    painter.setPen(QPen(borderColor, 2));
+    painter.setBrush(fillColor);
+    painter.drawEllipse(QRectF(1, 1, size - 2, size - 2));
+    painter.end();
+
+    _indicatorCache.insert(key, pixmap);
+    return pixmap;
 }
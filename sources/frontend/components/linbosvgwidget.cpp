@@ -18,20 +18,26 @@
 
 #include "linbosvgwidget.h"
 
-LinboSvgWidget::LinboSvgWidget(int height, QString path, QWidget* parent) : QLabel(parent)
+LinboSvgWidget::LinboSvgWidget(int height, QString path, QWidget* parent) : QWidget(parent)
 {
-    QSvgRenderer* renderer = new QSvgRenderer(QString(path));
-    renderer->setAspectRatioMode(Qt::KeepAspectRatio);
+    this->_path = path;
+    this->_aspectRatioMode = Qt::KeepAspectRatio;
 
-    int linboLogoWidth = height * (renderer->defaultSize().width() / renderer->defaultSize().height());
+    QSize defaultSize = LinboSvgCache::defaultSize(path);
+    int width = defaultSize.isValid() ? height * (defaultSize.width() / defaultSize.height()) : height;
 
-    QImage* image = new QImage(linboLogoWidth, height, QImage::Format_ARGB32);
-    image->fill(QColor(0,0,0,0));
+    this->setFixedHeight(height);
+    this->setFixedWidth(width);
+}
 
-    QPainter painter(image);
-    renderer->render(&painter);
+LinboSvgWidget::LinboSvgWidget(QString path, QWidget* parent) : QWidget(parent)
+{
+    this->_path = path;
+    this->_aspectRatioMode = Qt::IgnoreAspectRatio;
+}
 
-    this->setPixmap(QPixmap::fromImage(*image));
-    this->setFixedHeight(height);
-    this->setFixedWidth(linboLogoWidth);
+void LinboSvgWidget::paintEvent(QPaintEvent *e) {
+    Q_UNUSED(e)
+    QPainter painter(this);
+    LinboSvgCache::paint(&painter, this->rect(), this->_path, QColor(), this->_aspectRatioMode);
 }
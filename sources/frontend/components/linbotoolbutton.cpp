@@ -33,10 +33,8 @@ LinboToolButton::LinboToolButton(QString text, LinboTheme::Icon icon, QWidget* p
 LinboToolButton::LinboToolButton(QString text, LinboTheme::Icon icon, LinboTheme::ColorRole colorRole, QWidget* parent) : LinboPushButton(gTheme->iconPath(icon), text, parent)
 {
     this->_colorRole = colorRole;
-}
 
-void LinboToolButton::paintEvent(QPaintEvent *e) {
-    LinboPushButton::paintEvent(e);
+    // only once, setting it while painting re-polishes the button on every frame
     LinboPushButton::setStyleSheet(
         QString(
             "QLabel { "
@@ -31,8 +31,8 @@ LinboLoginDialog::LinboLoginDialog(LinboBackend* backend, QWidget* parent) : Lin
     this->setAutoFillBackground(false);
     this->setAttribute(Qt::WA_TranslucentBackground, true);
 
-    // Lock icon renderer (painted in paintEvent)
-    this->_lockRenderer = new QSvgRenderer(QStringLiteral(":/icons/universal/lock.svg"), this);
+    // Lock icon (painted in paintEvent)
+    this->_lockIconPath = QStringLiteral(":/icons/universal/lock.svg");
 
     // Password input — Normal mode, we handle masking manually with bullets
     this->_passwordInput = new QLineEdit(this);
@@ -63,6 +63,8 @@ LinboLoginDialog::LinboLoginDialog(LinboBackend* backend, QWidget* parent) : Lin
     this->_shakeTimer = new QTimer(this);
     this->_shakeTimer->setInterval(30);
     connect(this->_shakeTimer, &QTimer::timeout, this, &LinboLoginDialog::_shakeStep_slot);
+    if(gIdleGovernor != nullptr)
+        gIdleGovernor->bindTimer(this->_shakeTimer, this);
 }
 
 void LinboLoginDialog::_onTextChanged(const QString &text) {
@@ -140,13 +142,13 @@ void LinboLoginDialog::paintEvent(QPaintEvent *e) {
     painter.drawRoundedRect(QRectF(rect()).adjusted(0.75, 0.75, -0.75, -0.75), radius, radius);
 
     // Lock icon (left side)
-    if(this->_lockRenderer && this->_lockRenderer->isValid()) {
+    if(LinboSvgCache::isValid(this->_lockIconPath)) {
         int iconSize = h * 0.4;
         int iconX = h * 0.35;
         int iconY = (h - iconSize) / 2;
         // Tint: use opacity to indicate state
         painter.setOpacity(this->_wrongPassword ? 0.5 : 0.35);
-        this->_lockRenderer->render(&painter, QRectF(iconX, iconY, iconSize, iconSize));
+        LinboSvgCache::paint(&painter, QRectF(iconX, iconY, iconSize, iconSize), this->_lockIconPath);
         painter.setOpacity(1.0);
     }
 
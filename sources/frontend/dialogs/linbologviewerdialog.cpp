@@ -0,0 +1,173 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbologviewerdialog.h"
+
+LinboLogViewerDialog::LinboLogViewerDialog(LinboBackend* backend, QWidget* parent) : LinboDialog(parent)
+{
+    this->_backend = backend;
+    this->_followTail = true;
+
+    //% "Logs"
+    this->setTitle(qtTrId("dialog_logViewer_title"));
+
+    this->_logModel = new LinboLogModel(this->_backend->logger(), this);
+
+    this->_mainLayout = new QVBoxLayout(this);
+
+    // --- Filter row ---
+    QHBoxLayout* filterLayout = new QHBoxLayout();
+    this->_mainLayout->addLayout(filterLayout);
+
+    this->_searchEdit = new LinboLineEdit();
+    //% "Search"
+    this->_searchEdit->setPlaceholderText(qtTrId("dialog_logViewer_search"));
+    filterLayout->addWidget(this->_searchEdit, 2);
+    connect(this->_searchEdit, &LinboLineEdit::textChanged, this->_logModel, &LinboLogModel::setSearchText);
+
+    this->_typeFilterBox = new LinboComboBox();
+    //% "All messages"
+    this->_typeFilterBox->addItem(qtTrId("dialog_logViewer_types_all"), int(this->_logModel->typeFilter()));
+    //% "Errors only"
+    this->_typeFilterBox->addItem(qtTrId("dialog_logViewer_types_errors"), int(LinboLogger::StdErr | LinboLogger::LinboGuiError));
+    //% "GUI messages"
+    this->_typeFilterBox->addItem(qtTrId("dialog_logViewer_types_gui"), int(
+                                      LinboLogger::LinboGuiInfo | LinboLogger::LinboGuiError |
+                                      LinboLogger::LinboLogChapterBeginning | LinboLogger::LinboLogChapterEnd
+                                      ));
+    //% "Command output"
+    this->_typeFilterBox->addItem(qtTrId("dialog_logViewer_types_output"), int(LinboLogger::StdOut | LinboLogger::StdErr));
+    filterLayout->addWidget(this->_typeFilterBox, 1);
+    connect(this->_typeFilterBox, &QComboBox::currentIndexChanged, this, [=]() {
+        this->_logModel->setTypeFilter(LinboLogger::LinboLogTypes(this->_typeFilterBox->currentData().toInt()));
+    });
+
+    this->_chapterFilterBox = new LinboComboBox();
+    filterLayout->addWidget(this->_chapterFilterBox, 1);
+    connect(this->_chapterFilterBox, &QComboBox::currentIndexChanged, this, [=]() {
+        QVariant chapter = this->_chapterFilterBox->currentData();
+        this->_logModel->setChapterFilter(chapter.isValid() ? chapter.toLongLong() : -1);
+    });
+    connect(this->_logModel, &LinboLogModel::chapterAdded, this, &LinboLogViewerDialog::_handleChapterAdded);
+
+    // --- Log list ---
+    // Only the visible rows are ever laid out and painted,
+    // which keeps this fast even with the complete history loaded
+    this->_logView = new QListView();
+    this->_logView->setModel(this->_logModel);
+    this->_logView->setUniformItemSizes(true);
+    this->_logView->setLayoutMode(QListView::Batched);
+    this->_logView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    this->_logView->setSelectionMode(QAbstractItemView::NoSelection);
+    this->_logView->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    this->_logView->setStyleSheet(
+        "QListView {"
+        "    border: 1px solid #333333;"
+        "    border-radius: 4px;"
+        "    background: #1a1a1a;"
+        "    padding: 6px;"
+        "}"
+        "QListView:focus {"
+        "    border: 1px solid #0081c6;"
+        "}"
+        "QScrollBar:vertical {"
+        "    background: #1a1a1a;"
+        "    width: 8px;"
+        "    margin: 0px;"
+        "}"
+        "QScrollBar::handle:vertical {"
+        "    background: #333333;"
+        "    min-height: 20px;"
+        "    border-radius: 4px;"
+        "}"
+        "QScrollBar::add-line:vertical { height: 0px; }"
+        "QScrollBar::sub-line:vertical { height: 0px; }"
+        );
+    this->_mainLayout->addWidget(this->_logView);
+
+    // Keep following new output as long as the user is at the bottom
+    connect(this->_logView->verticalScrollBar(), &QScrollBar::valueChanged, this, [=](int value) {
+        this->_followTail = value >= this->_logView->verticalScrollBar()->maximum();
+    });
+    connect(this->_logModel, &LinboLogModel::rowsInserted, this, &LinboLogViewerDialog::_handleRowsInserted);
+    connect(this->_logModel, &LinboLogModel::modelReset, this, &LinboLogViewerDialog::_handleRowsInserted);
+
+    //% "close"
+    LinboToolButton* closeButton = new LinboToolButton(qtTrId("dialog_logViewer_button_close"));
+    this->addToolButton(closeButton);
+    connect(closeButton, &LinboToolButton::clicked, this, &LinboLogViewerDialog::autoClose);
+
+    connect(this, &LinboLogViewerDialog::opened, this, [=]() {
+        this->_refreshChapterList();
+        this->_followTail = true;
+        this->_logView->scrollToBottom();
+        this->_searchEdit->setFocus();
+    });
+
+    this->_refreshChapterList();
+}
+
+void LinboLogViewerDialog::resizeEvent(QResizeEvent *event) {
+    LinboDialog::resizeEvent(event);
+
+    int margins = gTheme->size(LinboTheme::Margins);
+    int rowHeight = gTheme->size(LinboTheme::RowHeight);
+    int rowFontSize = gTheme->size(LinboTheme::RowFontSize);
+    int padding = gTheme->size(LinboTheme::RowPaddingSize);
+
+    this->_mainLayout->setContentsMargins(padding, margins, padding, padding);
+    this->_mainLayout->setSpacing(padding);
+
+    QFont filterFont;
+    filterFont.setPixelSize(rowFontSize);
+    this->_searchEdit->setFixedHeight(rowHeight);
+    this->_searchEdit->setFont(filterFont);
+    this->_typeFilterBox->setFixedHeight(rowHeight);
+    this->_typeFilterBox->setFont(filterFont);
+    this->_chapterFilterBox->setFixedHeight(rowHeight);
+    this->_chapterFilterBox->setFont(filterFont);
+
+    QFont logFont("Ubuntu Mono");
+    logFont.setPixelSize(rowFontSize * 0.8);
+    this->_logView->setFont(logFont);
+}
+
+void LinboLogViewerDialog::_refreshChapterList() {
+    QVariant currentChapter = this->_chapterFilterBox->currentData();
+
+    QSignalBlocker blocker(this->_chapterFilterBox);
+    this->_chapterFilterBox->clear();
+    //% "All chapters"
+    this->_chapterFilterBox->addItem(qtTrId("dialog_logViewer_chapters_all"));
+    for(const QPair<quint32, QString>& chapter : this->_logModel->chapters())
+        this->_chapterFilterBox->addItem(chapter.second, chapter.first);
+
+    int currentIndex = currentChapter.isValid() ? this->_chapterFilterBox->findData(currentChapter) : 0;
+    this->_chapterFilterBox->setCurrentIndex(qMax(0, currentIndex));
+    if(currentIndex < 0)
+        this->_logModel->setChapterFilter(-1);
+}
+
+void LinboLogViewerDialog::_handleChapterAdded(quint32 chapter, QString name) {
+    this->_chapterFilterBox->addItem(name, chapter);
+}
+
+void LinboLogViewerDialog::_handleRowsInserted() {
+    if(this->_followTail)
+        this->_logView->scrollToBottom();
+}
@@ -72,6 +72,16 @@ LinboUpdateCacheDialog::LinboUpdateCacheDialog(LinboBackend* backend, QWidget* p
     this->addToolButton(updateButton);
     connect(updateButton, &LinboToolButton::clicked, this, &LinboUpdateCacheDialog::_updateCache);
 
+    // Only offered when images of the last cache update failed
+    //% "retry failed"
+    this->_retryButton = new LinboToolButton(qtTrId("dialog_updateCache_button_retryFailed"));
+    this->addToolButton(this->_retryButton);
+    this->_retryButton->setVisible(false);
+    connect(this->_retryButton, &LinboToolButton::clicked, this, &LinboUpdateCacheDialog::_retryFailedImages);
+    connect(this, &LinboDialog::opened, this, [=] {
+        this->_retryButton->setVisible(this->_backend->cacheUpdater()->hasFailedImages());
+    });
+
     //% "cancel"
     LinboToolButton* cancelButton = new LinboToolButton(qtTrId("cancel"));
     this->addToolButton(cancelButton);
@@ -83,6 +93,11 @@ void LinboUpdateCacheDialog::_updateCache() {
     this->close();
 }
 
+void LinboUpdateCacheDialog::_retryFailedImages() {
+    this->_backend->retryCacheUpdate();
+    this->close();
+}
+
 void LinboUpdateCacheDialog::resizeEvent(QResizeEvent *event) {
     LinboDialog::resizeEvent(event);
 
@@ -0,0 +1,59 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linboanimationclock.h"
+
+LinboAnimationClock* gAnimationClock = nullptr;
+
+LinboAnimationClock::LinboAnimationClock(int framesPerSecond, QObject* parent) : QAnimationDriver(parent)
+{
+    gAnimationClock = this;
+
+    // 0 means the refresh rate of the screen (linuxfb reports 60Hz)
+    if(framesPerSecond <= 0 && QGuiApplication::primaryScreen() != nullptr)
+        framesPerSecond = qRound(QGuiApplication::primaryScreen()->refreshRate());
+    this->_framesPerSecond = qBound(1, framesPerSecond > 0 ? framesPerSecond : 60, 120);
+
+    this->_tickTimer = new QTimer(this);
+    this->_tickTimer->setTimerType(Qt::PreciseTimer);
+    this->_tickTimer->setInterval(1000 / this->_framesPerSecond);
+    connect(this->_tickTimer, &QTimer::timeout, this, &LinboAnimationClock::_handleTick);
+}
+
+qint64 LinboAnimationClock::elapsed() const {
+    return this->_elapsedTimer.isValid() ? this->_elapsedTimer.elapsed() : 0;
+}
+
+void LinboAnimationClock::start() {
+    this->_elapsedTimer.start();
+    this->_tickTimer->start();
+    QAnimationDriver::start();
+}
+
+void LinboAnimationClock::stop() {
+    // nothing is animating anymore, do not wake up until the next animation starts
+    this->_tickTimer->stop();
+    QAnimationDriver::stop();
+}
+
+void LinboAnimationClock::_handleTick() {
+    // all animations set their values here, the widgets only schedule an update
+    // which Qt merges into one paint event after this tick
+    this->advance();
+    emit this->ticked();
+}
@@ -0,0 +1,81 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbobackgroundlayer.h"
+
+LinboBackgroundLayer::LinboBackgroundLayer(const QString& logoPath)
+{
+    this->_logoPath = logoPath;
+    this->_layerLowFxMode = false;
+}
+
+void LinboBackgroundLayer::paint(QPainter* painter, QSize size, const QRegion& region) {
+    if(this->_layer.size() != size || this->_layerLowFxMode != gTheme->lowFxMode())
+        this->_composite(size);
+
+    for(const QRect& rect : region)
+        painter->drawPixmap(rect, this->_layer, rect);
+}
+
+void LinboBackgroundLayer::_composite(QSize size) {
+    this->_layerLowFxMode = gTheme->lowFxMode();
+
+    // Paint gradient at small size, then scale up — smooths out banding
+    int smallW = 64;
+    int smallH = 64;
+    QImage small(smallW, smallH, QImage::Format_RGB32);
+    QPainter smallPainter(&small);
+
+    smallPainter.fillRect(small.rect(), QColor(12, 12, 12));
+
+    if(!this->_layerLowFxMode) {
+        QLinearGradient wave(smallW, 0, 0, smallH);
+        wave.setSpread(QGradient::PadSpread);
+        wave.setColorAt(0.00, QColor(22, 22, 22));
+        wave.setColorAt(0.08, QColor(20, 20, 20));
+        wave.setColorAt(0.18, QColor(15, 15, 15));
+        wave.setColorAt(0.28, QColor(20, 20, 20));
+        wave.setColorAt(0.38, QColor(15, 15, 15));
+        wave.setColorAt(0.48, QColor(21, 21, 21));
+        wave.setColorAt(0.58, QColor(14, 14, 14));
+        wave.setColorAt(0.68, QColor(19, 19, 19));
+        wave.setColorAt(0.78, QColor(14, 14, 14));
+        wave.setColorAt(0.88, QColor(20, 20, 20));
+        wave.setColorAt(1.00, QColor(18, 18, 18));
+        smallPainter.fillRect(small.rect(), wave);
+    }
+    smallPainter.end();
+
+    // Scale up with smooth bilinear filtering — eliminates banding
+    QImage layer = small.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    // Edulution logo, top-right, subtle
+    if(!this->_logoPath.isEmpty() && LinboSvgCache::isValid(this->_logoPath)) {
+        int logoH = size.height() * 0.051;
+        // SVG aspect ratio ~841.9:228.4 ≈ 3.69:1
+        int logoW = logoH * 841.9 / 228.4;
+        int margin = size.height() * 0.025;
+
+        QPainter layerPainter(&layer);
+        layerPainter.drawPixmap(size.width() - logoW - margin, margin, LinboSvgCache::pixmap(this->_logoPath, QSize(logoW, logoH)));
+        layerPainter.end();
+    }
+
+    // in the format of the framebuffer, so a blit is a plain copy
+    this->_layer = QPixmap::fromImage(LinboRenderConfig::toOpaqueFormat(layer));
+}
@@ -0,0 +1,113 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linboidlegovernor.h"
+
+LinboIdleGovernor* gIdleGovernor = nullptr;
+
+LinboIdleGovernor::LinboIdleGovernor(QObject* parent) : QObject(parent)
+{
+    gIdleGovernor = this;
+}
+
+void LinboIdleGovernor::bindAnimation(QAbstractAnimation* animation, QWidget* target) {
+    this->_bind(_Binding{target, animation, nullptr, false});
+
+    connect(animation, &QAbstractAnimation::stateChanged, this, [=](QAbstractAnimation::State newState) {
+        if(newState != QAbstractAnimation::Running)
+            return;
+
+        for(_Binding& binding : this->_bindings)
+            if(binding.animation == animation && !binding.target->isVisible())
+                this->_suspend(binding);
+    });
+}
+
+void LinboIdleGovernor::bindTimer(QTimer* timer, QWidget* target) {
+    this->_bind(_Binding{target, nullptr, timer, false});
+}
+
+int LinboIdleGovernor::suspendedCount() {
+    int count = 0;
+    for(const _Binding& binding : this->_bindings)
+        if(binding.suspended)
+            count++;
+    return count;
+}
+
+bool LinboIdleGovernor::eventFilter(QObject* watched, QEvent* event) {
+    if(event->type() != QEvent::Hide && event->type() != QEvent::Show)
+        return QObject::eventFilter(watched, event);
+
+    for(_Binding& binding : this->_bindings) {
+        if(binding.target != watched)
+            continue;
+
+        if(event->type() == QEvent::Hide)
+            this->_suspend(binding);
+        else
+            this->_resume(binding);
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void LinboIdleGovernor::_bind(_Binding binding) {
+    QObject* suspendable = binding.animation != nullptr ? (QObject*)binding.animation : (QObject*)binding.timer;
+
+    // hide and show events are delivered to every child of a widget that is hidden or shown
+    binding.target->installEventFilter(this);
+    connect(binding.target, &QObject::destroyed, this, &LinboIdleGovernor::_removeBindingsOf, Qt::UniqueConnection);
+    connect(suspendable, &QObject::destroyed, this, &LinboIdleGovernor::_removeBindingsOf, Qt::UniqueConnection);
+
+    this->_bindings.append(binding);
+    if(!binding.target->isVisible())
+        this->_suspend(this->_bindings.last());
+}
+
+void LinboIdleGovernor::_suspend(_Binding& binding) {
+    if(binding.animation != nullptr && binding.animation->state() == QAbstractAnimation::Running) {
+        binding.suspended = true;
+        binding.animation->pause();
+    }
+    else if(binding.timer != nullptr && binding.timer->isActive()) {
+        binding.suspended = true;
+        binding.timer->stop();
+    }
+}
+
+void LinboIdleGovernor::_resume(_Binding& binding) {
+    if(!binding.suspended)
+        return;
+
+    binding.suspended = false;
+
+    // only resume what was suspended here, it might have been stopped in the meantime
+    if(binding.animation != nullptr && binding.animation->state() == QAbstractAnimation::Paused)
+        binding.animation->resume();
+    else if(binding.timer != nullptr)
+        binding.timer->start();
+}
+
+void LinboIdleGovernor::_removeBindingsOf(QObject* object) {
+    for(int i = this->_bindings.length() - 1; i >= 0; i--) {
+        const _Binding& binding = this->_bindings.at(i);
+        if(binding.target == object || binding.animation == object || binding.timer == object)
+            this->_bindings.removeAt(i);
+    }
+}
@@ -0,0 +1,227 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbologmodel.h"
+
+LinboLogModel::LinboLogModel(LinboLogger* logger, QObject* parent) : QAbstractListModel(parent)
+{
+    this->_logger = logger;
+    this->_nextSequence = 0;
+    this->_typeFilter = LinboLogger::LinboLogTypes(
+                LinboLogger::StdOut | LinboLogger::StdErr | LinboLogger::LinboGuiInfo | LinboLogger::LinboGuiError |
+                LinboLogger::LinboLogChapterBeginning | LinboLogger::LinboLogChapterEnd
+                );
+    this->_chapterFilter = -1;
+
+    // Coalesce bursts of output (eg. rsync) into one insertion
+    this->_appendTimer = new QTimer(this);
+    this->_appendTimer->setSingleShot(true);
+    this->_appendTimer->setInterval(100);
+    connect(this->_appendTimer, &QTimer::timeout, this, &LinboLogModel::_appendNewLogs);
+
+    connect(this->_logger, &LinboLogger::latestLogChanged, this, &LinboLogModel::_handleLatestLogChanged);
+    connect(this->_logger, &LinboLogger::latestBackgroundLogChanged, this, &LinboLogModel::_handleLatestLogChanged);
+
+    this->refresh();
+}
+
+int LinboLogModel::rowCount(const QModelIndex& parent) const {
+    if(parent.isValid())
+        return 0;
+    return this->_sequences.length();
+}
+
+QVariant LinboLogModel::data(const QModelIndex& index, int role) const {
+    if(!index.isValid() || index.row() >= this->_sequences.length())
+        return QVariant();
+
+    LinboLogger::LinboLogView logs = this->_logger->logs();
+    quint64 sequence = this->_sequences.at(index.row());
+    if(sequence < logs.firstSequence() || sequence >= logs.endSequence())
+        return QVariant();
+
+    const LinboLogger::LinboLog& log = logs.at(sequence - logs.firstSequence());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return log.time.toString("hh:mm:ss") + " [" + LinboLogger::logTypeToString(log.type) + "] " + log.message;
+    case Qt::ToolTipRole:
+        return log.message;
+    case Qt::ForegroundRole:
+        switch (log.type) {
+        case LinboLogger::StdErr:
+        case LinboLogger::LinboGuiError:
+            return QColor("#dc2626");
+        case LinboLogger::LinboLogChapterBeginning:
+        case LinboLogger::LinboLogChapterEnd:
+            return QColor("#8fc046");
+        case LinboLogger::LinboGuiInfo:
+            return gTheme->textAt(230);
+        default:
+            return gTheme->textAt(160);
+        }
+    case LogTypeRole:
+        return int(log.type);
+    case ChapterRole:
+        return log.chapter;
+    default:
+        return QVariant();
+    }
+}
+
+void LinboLogModel::setTypeFilter(LinboLogger::LinboLogTypes types) {
+    if(types == this->_typeFilter)
+        return;
+    this->_typeFilter = types;
+    this->refresh();
+}
+
+LinboLogger::LinboLogTypes LinboLogModel::typeFilter() {
+    return this->_typeFilter;
+}
+
+void LinboLogModel::setChapterFilter(qint64 chapter) {
+    if(chapter == this->_chapterFilter)
+        return;
+    this->_chapterFilter = chapter;
+    this->refresh();
+}
+
+qint64 LinboLogModel::chapterFilter() {
+    return this->_chapterFilter;
+}
+
+void LinboLogModel::setSearchText(QString searchText) {
+    if(searchText == this->_searchText)
+        return;
+
+    bool narrowing = !this->_searchText.isEmpty() && searchText.contains(this->_searchText, Qt::CaseInsensitive);
+    this->_searchText = searchText;
+
+    if(!narrowing) {
+        this->refresh();
+        return;
+    }
+
+    // Every row matching the new text also matched the old one,
+    // so only the current rows have to be checked again
+    this->_appendNewLogs();
+    LinboLogger::LinboLogView logs = this->_logger->logs();
+    QList<quint64> sequences;
+    sequences.reserve(this->_sequences.length());
+    for(quint64 sequence : std::as_const(this->_sequences)) {
+        if(sequence >= logs.firstSequence() && this->_matches(logs.at(sequence - logs.firstSequence())))
+            sequences.append(sequence);
+    }
+
+    this->beginResetModel();
+    this->_sequences = sequences;
+    this->endResetModel();
+}
+
+QString LinboLogModel::searchText() {
+    return this->_searchText;
+}
+
+QList<QPair<quint32, QString>> LinboLogModel::chapters() {
+    QList<QPair<quint32, QString>> chapters;
+    for(const LinboLogger::LinboLog& log : this->_logger->logs()) {
+        if(log.type == LinboLogger::LinboLogChapterBeginning)
+            chapters.append(QPair<quint32, QString>(log.chapter, log.message));
+    }
+    return chapters;
+}
+
+void LinboLogModel::refresh() {
+    this->_appendTimer->stop();
+
+    LinboLogger::LinboLogView logs = this->_logger->logs();
+    QList<quint64> sequences;
+    quint64 sequence = logs.firstSequence();
+    for(const LinboLogger::LinboLog& log : logs) {
+        if(this->_matches(log))
+            sequences.append(sequence);
+        sequence++;
+    }
+
+    this->beginResetModel();
+    this->_sequences = sequences;
+    this->_nextSequence = logs.endSequence();
+    this->endResetModel();
+}
+
+// -----------
+// - Helpers -
+// -----------
+
+bool LinboLogModel::_matches(const LinboLogger::LinboLog& log) const {
+    if(!this->_typeFilter.testFlag(log.type))
+        return false;
+
+    if(this->_chapterFilter >= 0 && log.chapter != quint64(this->_chapterFilter))
+        return false;
+
+    if(!this->_searchText.isEmpty() && !log.message.contains(this->_searchText, Qt::CaseInsensitive))
+        return false;
+
+    return true;
+}
+
+void LinboLogModel::_dropEvictedRows() {
+    quint64 firstSequence = this->_logger->logs().firstSequence();
+    int evictedRows = 0;
+    while(evictedRows < this->_sequences.length() && this->_sequences.at(evictedRows) < firstSequence)
+        evictedRows++;
+
+    if(evictedRows == 0)
+        return;
+
+    this->beginRemoveRows(QModelIndex(), 0, evictedRows - 1);
+    this->_sequences.remove(0, evictedRows);
+    this->endRemoveRows();
+}
+
+void LinboLogModel::_handleLatestLogChanged(const LinboLogger::LinboLog& latestLog) {
+    if(latestLog.type == LinboLogger::LinboLogChapterBeginning)
+        emit this->chapterAdded(latestLog.chapter, latestLog.message);
+
+    if(!this->_appendTimer->isActive())
+        this->_appendTimer->start();
+}
+
+void LinboLogModel::_appendNewLogs() {
+    this->_appendTimer->stop();
+    this->_dropEvictedRows();
+
+    LinboLogger::LinboLogView logs = this->_logger->logs();
+    quint64 sequence = qMax(this->_nextSequence, logs.firstSequence());
+
+    QList<quint64> newSequences;
+    for(; sequence < logs.endSequence(); sequence++) {
+        if(this->_matches(logs.at(sequence - logs.firstSequence())))
+            newSequences.append(sequence);
+    }
+    this->_nextSequence = logs.endSequence();
+
+    if(newSequences.isEmpty())
+        return;
+
+    this->beginInsertRows(QModelIndex(), this->_sequences.length(), this->_sequences.length() + newSequences.length() - 1);
+    this->_sequences.append(newSequences);
+    this->endInsertRows();
+}
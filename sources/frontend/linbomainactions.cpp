@@ -24,6 +24,10 @@ LinboMainActions::LinboMainActions(LinboBackend* backend, QWidget *parent) : QWi
     connect(this->_backend, &LinboBackend::stateChanged, this, &LinboMainActions::_handleLinboStateChanged);
     connect(this->_backend, &LinboBackend::timeoutProgressChanged, this, &LinboMainActions::_handleTimeoutProgressChanged);
     connect(this->_backend->logger(), &LinboLogger::latestLogChanged, this, &LinboMainActions::_handleLatestLogChanged);
+    connect(this->_backend->logger(), &LinboLogger::latestBackgroundLogChanged, this, &LinboMainActions::_handleLatestBackgroundLogChanged);
+    connect(this->_backend->jobQueue(), &LinboJobQueue::jobStatusChanged, this, &LinboMainActions::_updateBackgroundLogLabel);
+    connect(this->_backend->cacheUpdater(), &LinboCacheUpdater::imageStatusChanged, this, &LinboMainActions::_updateCacheProgressLabel);
+    connect(this->_backend->cacheUpdater(), &LinboCacheUpdater::progressChanged, this, &LinboMainActions::_updateCacheProgressLabel);
 
     this->_stackView = new LinboStackedWidget(this);
 
@@ -39,20 +43,32 @@ LinboMainActions::LinboMainActions(LinboBackend* backend, QWidget *parent) : QWi
 
     this->_logLabel = new QLabel("", this->_progressBarWidget);
     this->_logLabel->setAlignment(Qt::AlignCenter);
+    // Output of a job running next to the current one (eg. a pipelined upload)
+    this->_backgroundLogLabel = new QLabel("", this->_progressBarWidget);
+    this->_backgroundLogLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+    this->_backgroundLogLabel->setVisible(false);
+
     this->_passedTimeLabel = new QLabel("00:00", this->_progressBarWidget);
     this->_passedTimeLabel->setAlignment(Qt::AlignCenter);
 
-    this->_passedTimeTimer = new QTimer(this->_progressBarWidget);
-    connect(this->_passedTimeTimer, &QTimer::timeout, this, [=]() {
-        int passedSecs = QDateTime::currentSecsSinceEpoch() - this->_processStartedAt;
-        QString passedTime =
-            QStringLiteral("%1").arg(passedSecs / 60, 2, 10, QLatin1Char('0'))
-            + ":"
-            + QStringLiteral("%1").arg(passedSecs % 60, 2, 10, QLatin1Char('0'));
-        this->_passedTimeLabel->setText(passedTime);
-    });
-    this->_passedTimeTimer->setInterval(1000);
+    // only runs while the passed time is shown, the label changes once per second anyway
+    this->_passedTimeShown = false;
+    this->_passedSeconds = 0;
     this->_processStartedAt = QDateTime::currentSecsSinceEpoch();
+    this->_passedTimeTimer = new QTimer(this);
+    this->_passedTimeTimer->setInterval(1000);
+    if(gIdleGovernor != nullptr)
+        gIdleGovernor->bindTimer(this->_passedTimeTimer, this->_passedTimeLabel);
+    connect(this->_passedTimeTimer, &QTimer::timeout, this, &LinboMainActions::_updatePassedTimeLabel);
+
+    // the backend only refreshes the countdown a few times per second, this animates the bar in between
+    this->_countdownAnimation = new QVariantAnimation(this);
+    this->_countdownAnimation->setEndValue(0);
+    if(gIdleGovernor != nullptr)
+        gIdleGovernor->bindAnimation(this->_countdownAnimation, this->_progressBar);
+    connect(this->_countdownAnimation, &QVariantAnimation::valueChanged, this, [=](const QVariant& value) {
+        this->_progressBar->setValue(value.toInt());
+    });
 
     this->_cancelButton = new LinboToolButton(LinboTheme::CancelIcon, this->_progressBarWidget);
     connect(this->_cancelButton, &LinboToolButton::clicked, this->_backend, &LinboBackend::cancelCurrentAction);
@@ -112,6 +128,13 @@ void LinboMainActions::_resizeAndPositionAllItems() {
     this->_passedTimeLabel->setGeometry((this->_progressBarWidget->width() - logLabelWidth) / 2, this->_progressBar->y() + progressBarHeight + defaultSpacing, logLabelWidth, logLabelHeight);
 
     this->_cancelButton->setGeometry((this->_progressBarWidget->width() - cancelButtonWidth) / 2, this->_passedTimeLabel->y() + logLabelHeight + defaultSpacing, cancelButtonWidth, cancelButtonWidth);
+
+    // right of the cancel button, there is no room for another row
+    fontCache = this->_backgroundLogLabel->font();
+    fontCache.setPixelSize(gTheme->toFontSize(logLabelHeight * 0.5));
+    this->_backgroundLogLabel->setFont(fontCache);
+    int backgroundLogLabelX = this->_cancelButton->x() + cancelButtonWidth + defaultSpacing;
+    this->_backgroundLogLabel->setGeometry(backgroundLogLabelX, this->_cancelButton->y(), (this->_progressBarWidget->width() + logLabelWidth) / 2 - backgroundLogLabelX, cancelButtonWidth);
     if(cancelButtonWidth > 0)
         // Workaround to focus the cancel button on autostart
         this->_cancelButton->setFocus(Qt::PopupFocusReason);
@@ -164,14 +187,14 @@ void LinboMainActions::_handleCurrentOsChanged(LinboOs* newOs) {
 void LinboMainActions::_handleLinboStateChanged(LinboBackend::LinboState newState) {
 
     QWidget* currentWidget = nullptr;
+    this->_passedTimeShown = false;
     this->_passedTimeTimer->stop();
+    this->_countdownAnimation->stop();
 
     switch (newState) {
     case LinboBackend::Autostarting:
     case LinboBackend::RootTimeout:
-        this->_progressBar->setIndeterminate(false);
-        this->_progressBar->setReversed(true);
-        this->_progressBar->setValue(0);
+        this->_showCountdown();
         currentWidget = this->_progressBarWidget;
         break;
     case LinboBackend::Idle:
@@ -191,19 +214,17 @@ void LinboMainActions::_handleLinboStateChanged(LinboBackend::LinboState newStat
     case LinboBackend::Reinstalling:
     case LinboBackend::Partitioning:
     case LinboBackend::UpdatingCache:
-        this->_passedTimeLabel->setText("00:00");
-        this->_processStartedAt = QDateTime::currentSecsSinceEpoch();
-        this->_passedTimeTimer->start();
-        this->_progressBar->setIndeterminate(true);
-        this->_progressBar->setReversed(false);
+    case LinboBackend::SyncingOs:
+        this->_showPassedTime();
         currentWidget = this->_progressBarWidget;
         break;
 
     case LinboBackend::StartActionError:
     case LinboBackend::RootActionError: {
-        QList<LinboLogger::LinboLog> chaperLogs = this->_backend->logger()->logsOfCurrentChapter();
+        LinboLogger::LinboLogView chaperLogs = this->_backend->logger()->logsOfCurrentChapter();
+        QString chapterName = this->_backend->logger()->currentChapterTitle();
         QString errorDetails;
-        if(chaperLogs.length() == 0) {
+        if(chaperLogs.isEmpty()) {
             //% "The process %1 crashed:"
             this->_messageLabel->setText(qtTrId("main_message_processCrashed").arg("\"?\""));
             //% "No logs before this crash"
@@ -211,10 +232,11 @@ void LinboMainActions::_handleLinboStateChanged(LinboBackend::LinboState newStat
         }
         else {
             //% "The process %1 crashed:"
-            this->_messageLabel->setText(qtTrId("main_message_processCrashed").arg("\"" + chaperLogs[chaperLogs.length()-1].message + "\""));
+            this->_messageLabel->setText(qtTrId("main_message_processCrashed").arg("\"" + chapterName + "\""));
             //% "The last logs before the crash were:"
             errorDetails = "<b>" + qtTrId("main_message_lastLogs") + "</b><br>";
-            errorDetails += LinboLogger::logsToStacktrace(chaperLogs).join("<br>");
+            // The complete chapter can be inspected in the log viewer
+            errorDetails += LinboLogger::logsToStacktrace(chaperLogs, 200).join("<br>");
         }
 
         //% "Please ask your system administrator for help."
@@ -228,9 +250,11 @@ void LinboMainActions::_handleLinboStateChanged(LinboBackend::LinboState newStat
     }
 
     case LinboBackend::RootActionSuccess: {
-        QList<LinboLogger::LinboLog> chaperLogs = this->_backend->logger()->logsOfCurrentChapter();
+        QString chapterName = this->_backend->logger()->currentChapterTitle();
+        if(chapterName.isEmpty())
+            chapterName = "?";
         //% "The process %1 finished successfully."
-        this->_messageLabel->setText(qtTrId("main_message_processFinishedSuccessfully").arg("\"" + chaperLogs[chaperLogs.length()-1].message + "\"" ));
+        this->_messageLabel->setText(qtTrId("main_message_processFinishedSuccessfully").arg("\"" + chapterName + "\"" ));
         this->_messageDetailsTextBrowser->setText("");
         this->_messageLabel->setStyleSheet("QLabel { color : #8fc046; }");
         currentWidget = this->_messageWidget;
@@ -250,6 +274,8 @@ void LinboMainActions::_handleLinboStateChanged(LinboBackend::LinboState newStat
         this->_stackView->setCurrentWidgetAnimated(currentWidget);
     else
         this->_stackView->setCurrentWidget(currentWidget);
+
+    this->_updateBackgroundLogLabel();
 }
 
 void LinboMainActions::_handleLatestLogChanged(const LinboLogger::LinboLog& latestLog) {
@@ -265,22 +291,153 @@ void LinboMainActions::_handleLatestLogChanged(const LinboLogger::LinboLog& late
     this->_logLabel->setText(latestLog.message);
 }
 
+void LinboMainActions::_handleLatestBackgroundLogChanged(const LinboLogger::LinboLog& latestLog) {
+    LinboJobQueue* jobQueue = this->_backend->jobQueue();
+    LinboJob* backgroundJob = jobQueue->backgroundJob();
+    if(backgroundJob == nullptr)
+        return;
+
+    // Nothing is running in the foreground, so the background job is the current action
+    if(jobQueue->currentJob() == nullptr) {
+        this->_handleLatestLogChanged(latestLog);
+        return;
+    }
+
+    QString logColor = gTheme->textAt(160).name(QColor::HexArgb);
+    if (latestLog.type == LinboLogger::StdErr)
+        logColor = "#dc2626";
+
+    this->_backgroundLogLabel->setStyleSheet("QLabel { color : " + logColor + "; }");
+    QString text = backgroundJob->toString() + ": " + latestLog.message;
+    this->_backgroundLogLabel->setText(
+        this->_backgroundLogLabel->fontMetrics().elidedText(text, Qt::ElideRight, this->_backgroundLogLabel->width())
+    );
+}
+
+void LinboMainActions::_updateBackgroundLogLabel() {
+    if(this->_backend->state() == LinboBackend::UpdatingCache && this->_backend->cacheUpdater()->isRunning()) {
+        this->_updateCacheProgressLabel();
+        return;
+    }
+
+    LinboJobQueue* jobQueue = this->_backend->jobQueue();
+    bool visible = jobQueue->backgroundJob() != nullptr && jobQueue->currentJob() != nullptr;
+    if(!visible)
+        this->_backgroundLogLabel->setText("");
+    this->_backgroundLogLabel->setVisible(visible);
+}
+
+void LinboMainActions::_updateCacheProgressLabel() {
+    LinboCacheUpdater* cacheUpdater = this->_backend->cacheUpdater();
+    if(this->_backend->state() != LinboBackend::UpdatingCache || !cacheUpdater->isRunning())
+        return;
+
+    // The images are downloaded in parallel, so the main log label only shows the latest line of any of them
+    static const QRegularExpression percentRegex("(\\d{1,3})%");
+    QStringList imageProgress;
+    for(int i = 0; i < cacheUpdater->count(); i++) {
+        QString progress = LinboCacheUpdater::statusToString(cacheUpdater->status(i));
+        if(cacheUpdater->status(i) == LinboCacheUpdater::Downloading) {
+            QRegularExpressionMatch match = percentRegex.match(cacheUpdater->latestOutput(i));
+            if(match.hasMatch())
+                progress = match.captured(1) + "%";
+        }
+        imageProgress.append(cacheUpdater->imageName(i) + ": " + progress);
+    }
+
+    QString logColor = gTheme->textAt(160).name(QColor::HexArgb);
+    if(cacheUpdater->hasFailedImages())
+        logColor = "#dc2626";
+
+    this->_backgroundLogLabel->setStyleSheet("QLabel { color : " + logColor + "; }");
+    this->_backgroundLogLabel->setText(
+        this->_backgroundLogLabel->fontMetrics().elidedText(imageProgress.join(" | "), Qt::ElideRight, this->_backgroundLogLabel->width())
+    );
+    this->_backgroundLogLabel->setVisible(true);
+}
+
+void LinboMainActions::_showCountdown() {
+    this->_passedTimeShown = false;
+    this->_passedTimeTimer->stop();
+    this->_progressBar->setIndeterminate(false);
+    this->_progressBar->setReversed(true);
+    this->_progressBar->setValue(0);
+}
+
+void LinboMainActions::_showPassedTime() {
+    this->_countdownAnimation->stop();
+    this->_passedTimeLabel->setText("00:00");
+    this->_processStartedAt = QDateTime::currentSecsSinceEpoch();
+    this->_passedSeconds = 0;
+    this->_passedTimeShown = true;
+    this->_passedTimeTimer->start();
+    this->_progressBar->setIndeterminate(true);
+    this->_progressBar->setReversed(false);
+}
+
+void LinboMainActions::_updatePassedTimeLabel() {
+    if(!this->_passedTimeShown)
+        return;
+
+    int passedSecs = QDateTime::currentSecsSinceEpoch() - this->_processStartedAt;
+    if(passedSecs == this->_passedSeconds)
+        return;
+
+    this->_passedSeconds = passedSecs;
+    QString passedTime =
+        QStringLiteral("%1").arg(passedSecs / 60, 2, 10, QLatin1Char('0'))
+        + ":"
+        + QStringLiteral("%1").arg(passedSecs % 60, 2, 10, QLatin1Char('0'));
+    this->_passedTimeLabel->setText(passedTime);
+}
+
 void LinboMainActions::_handleTimeoutProgressChanged(double progress, int remaningMilliseconds) {
-    if(this->_backend->state() != LinboBackend::Autostarting && this->_backend->state() != LinboBackend::RootTimeout)
+    LinboBackend::LinboState state = this->_backend->state();
+    if(state != LinboBackend::Autostarting && state != LinboBackend::RootTimeout && state != LinboBackend::UpdatingCache)
         return;
 
+    // the automatic cache update waits for its admission delay first
+    if(state == LinboBackend::UpdatingCache) {
+        if(remaningMilliseconds <= 0) {
+            if(!this->_passedTimeShown)
+                this->_showPassedTime();
+            return;
+        }
+
+        if(this->_passedTimeShown)
+            this->_showCountdown();
+    }
+
     QString label = "";
+    int remainingAdmissionSeconds = (this->_backend->remainingAdmissionDelay() + 999) / 1000;
 
-    if(this->_backend->state() == LinboBackend::Autostarting) {
+    if(state == LinboBackend::Autostarting) {
         //% "Starting"
         label = qtTrId("main_autostart_label") + " " + this->_backend->osOfCurrentAction()->name();
+
+        if(remainingAdmissionSeconds > 0)
+            //% "(waiting %1s longer to spread the server load)"
+            label += " " + qtTrId("main_autostart_admissionDelay").arg(remainingAdmissionSeconds);
+    }
+    else if(state == LinboBackend::UpdatingCache) {
+        //% "Updating the cache in %1s to spread the server load"
+        label = qtTrId("main_updateCache_admissionDelay").arg(remainingAdmissionSeconds);
     }
     else {
         //% "Logging out automatically"
         label = qtTrId("main_rootTimeout_label");
     }
 
-    this->_progressBar->setValue(1000 - progress * 1000);
+    // only restart the animation when the countdown was restarted or the animation drifted
+    int value = 1000 - progress * 1000;
+    int animationRemainingMilliseconds = this->_countdownAnimation->duration() - this->_countdownAnimation->currentTime();
+    if(this->_countdownAnimation->state() != QAbstractAnimation::Running || qAbs(animationRemainingMilliseconds - remaningMilliseconds) > 100) {
+        this->_countdownAnimation->stop();
+        this->_countdownAnimation->setStartValue(value);
+        this->_countdownAnimation->setDuration(qMax(0, remaningMilliseconds));
+        this->_progressBar->setValue(value);
+        this->_countdownAnimation->start();
+    }
 
     this->_logLabel->setText(label);
 
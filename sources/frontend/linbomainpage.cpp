@@ -18,9 +18,11 @@
 
 #include "linbomainpage.h"
 
-LinboMainPage::LinboMainPage(LinboBackend* backend, QWidget *parent) : QWidget(parent)
+LinboMainPage::LinboMainPage(LinboBackend* backend, QWidget *parent) : QWidget(parent), _backgroundLayer(":/images/edulution_logo.svg")
 {
     this->setAutoFillBackground(false);
+    // the background layer covers every pixel
+    LinboRenderConfig::setOpaque(this);
     this->_inited = false;
     this->_showClientInfo = backend->config()->clientDetailsVisibleByDefault();
 
@@ -70,9 +72,6 @@ LinboMainPage::LinboMainPage(LinboBackend* backend, QWidget *parent) : QWidget(p
     subtitleLabel->setAlignment(Qt::AlignCenter);
     headerLayout->addWidget(subtitleLabel);
 
-    // Load edulution logo for top-right branding
-    this->_edulutionLogoRenderer = new QSvgRenderer(QString(":/images/edulution_logo.svg"), this);
-
     mainLayout->addWidget(this->_headerWidget);
     mainLayout->setAlignment(this->_headerWidget, Qt::AlignCenter);
 
@@ -193,6 +192,13 @@ LinboMainPage::LinboMainPage(LinboBackend* backend, QWidget *parent) : QWidget(p
     connect(this->_adminSidebar, &LinboAdminSidebar::terminalRequested,
             this->_terminalDialog, &LinboTerminalDialog::open);
 
+    this->_logViewerDialog = new LinboLogViewerDialog(backend, parent);
+    this->_allDialogs.append(this->_logViewerDialog);
+    this->_logViewerDialog->setGeometry(0, 0, std::min(dialogWidth * 2, int(this->width() * 0.9)), dialogHeight);
+    this->_logViewerDialog->centerInParent();
+    connect(this->_adminSidebar, &LinboAdminSidebar::logViewerRequested,
+            this->_logViewerDialog, &LinboLogViewerDialog::open);
+
     this->_confirmationDialog = new LinboConfirmationDialog(
         //% "Partition drive"
         qtTrId("dialog_partition_title"),
@@ -227,60 +233,9 @@ LinboMainPage::LinboMainPage(LinboBackend* backend, QWidget *parent) : QWidget(p
 }
 
 void LinboMainPage::paintEvent(QPaintEvent *event) {
-    Q_UNUSED(event)
+    // dark background with soft diagonal gradient and the edulution logo, composited once per size
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    // Dark background with soft diagonal gradient (anti-banding via upscale)
-    int w = this->width();
-    int h = this->height();
-
-    static QPixmap cachedBg;
-    static QSize cachedSize;
-
-    if(cachedBg.isNull() || cachedSize != this->size()) {
-        // Paint gradient at small size, then scale up — smooths out banding
-        int smallW = 64;
-        int smallH = 64;
-        QImage small(smallW, smallH, QImage::Format_RGB32);
-        QPainter sp(&small);
-
-        sp.fillRect(small.rect(), QColor(12, 12, 12));
-
-        if(!gTheme->lowFxMode()) {
-            QLinearGradient wave(smallW, 0, 0, smallH);
-            wave.setSpread(QGradient::PadSpread);
-            wave.setColorAt(0.00, QColor(22, 22, 22));
-            wave.setColorAt(0.08, QColor(20, 20, 20));
-            wave.setColorAt(0.18, QColor(15, 15, 15));
-            wave.setColorAt(0.28, QColor(20, 20, 20));
-            wave.setColorAt(0.38, QColor(15, 15, 15));
-            wave.setColorAt(0.48, QColor(21, 21, 21));
-            wave.setColorAt(0.58, QColor(14, 14, 14));
-            wave.setColorAt(0.68, QColor(19, 19, 19));
-            wave.setColorAt(0.78, QColor(14, 14, 14));
-            wave.setColorAt(0.88, QColor(20, 20, 20));
-            wave.setColorAt(1.00, QColor(18, 18, 18));
-            sp.fillRect(small.rect(), wave);
-        }
-        sp.end();
-
-        // Scale up with smooth bilinear filtering — eliminates banding
-        cachedBg = QPixmap::fromImage(small.scaled(w, h, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-        cachedSize = this->size();
-    }
-
-    painter.drawPixmap(0, 0, cachedBg);
-
-    // Edulution logo, top-right, subtle
-    if(this->_edulutionLogoRenderer && this->_edulutionLogoRenderer->isValid()) {
-        int logoH = this->height() * 0.051;
-        // SVG aspect ratio ~841.9:228.4 ≈ 3.69:1
-        int logoW = logoH * 841.9 / 228.4;
-        int margin = this->height() * 0.025;
-        painter.setOpacity(1.0);
-        this->_edulutionLogoRenderer->render(&painter, QRectF(this->width() - logoW - margin, margin, logoW, logoH));
-    }
+    this->_backgroundLayer.paint(&painter, this->size(), event->region());
 }
 
 void LinboMainPage::_handleLinboStateChanged(LinboBackend::LinboState newState) {
@@ -315,6 +270,7 @@ void LinboMainPage::_handleLinboStateChanged(LinboBackend::LinboState newState)
     // fall through
     case LinboBackend::Partitioning:
     case LinboBackend::UpdatingCache:
+    case LinboBackend::SyncingOs:
     case LinboBackend::Registering:
     case LinboBackend::Disabled:
         osSelectionRowHeight = this->height() * 0;
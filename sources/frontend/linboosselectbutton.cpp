@@ -32,8 +32,8 @@ LinboOsSelectButton::LinboOsSelectButton(QString icon, LinboOs* os, LinboBackend
         icon = gTheme->iconPath(LinboTheme::DefaultOsIcon);
     }
 
-    // OS icon renderer (drawn in paintEvent)
-    this->_iconRenderer = new QSvgRenderer(icon, this);
+    // OS icon (drawn in paintEvent), buttons of the same os share the pixmap
+    this->_iconPath = icon;
 
     connect(this->_backend, &LinboBackend::stateChanged, this, &LinboOsSelectButton::_handleBackendStateChange);
 
@@ -49,6 +49,8 @@ LinboOsSelectButton::LinboOsSelectButton(QString icon, LinboOs* os, LinboBackend
     this->_button->setOverlayTypeMuted(LinboPushButtonOverlay::OnKeyboardFocus, true);
 
     this->setToolTip(this->_os->description());
+    if(this->_os->baseImage() != nullptr)
+        connect(this->_os->baseImage(), &LinboImage::freshnessChanged, this, &LinboOsSelectButton::_handleFreshnessChanged);
     connect(this->_button, &LinboPushButton::clicked, this, &LinboOsSelectButton::_handlePrimaryButtonClicked);
 
     // Action labels
@@ -161,9 +163,30 @@ void LinboOsSelectButton::paintEvent(QPaintEvent *event) {
     int iconSize = h - pad * 2;
     int iconX = pad;
     QRectF iconRect(iconX, pad, iconSize, iconSize);
-    if(this->_iconRenderer && this->_iconRenderer->isValid()) {
-        this->_iconRenderer->render(&painter, iconRect);
+    LinboSvgCache::paint(&painter, iconRect, this->_iconPath);
+
+    // Freshness badge in the bottom right corner of the icon
+    if(this->_os->baseImage() == nullptr || this->_os->baseImage()->freshness() == LinboImage::UnknownFreshness)
+        return;
+
+    QColor badgeColor;
+    switch (this->_os->baseImage()->freshness()) {
+    case LinboImage::Fresh:
+        badgeColor = QColor("#8fc046");
+        break;
+    case LinboImage::Stale:
+        badgeColor = QColor("#f59e0b");
+        break;
+    default:
+        badgeColor = QColor("#dc2626");
+        break;
     }
+
+    qreal badgeSize = std::max(6.0, iconSize * 0.22);
+    QRectF badgeRect(iconRect.right() - badgeSize, iconRect.bottom() - badgeSize, badgeSize, badgeSize);
+    painter.setPen(QPen(gTheme->color(LinboTheme::BackgroundColor), std::max(1.0, badgeSize * 0.15)));
+    painter.setBrush(badgeColor);
+    painter.drawEllipse(badgeRect);
 }
 
 void LinboOsSelectButton::enterEvent(QEnterEvent *event) {
@@ -202,6 +225,33 @@ void LinboOsSelectButton::_handlePrimaryButtonClicked() {
     }
 }
 
+void LinboOsSelectButton::_handleFreshnessChanged() {
+    QString freshness;
+    switch (this->_os->baseImage()->freshness()) {
+    case LinboImage::Fresh:
+        //% "The cached image is up to date"
+        freshness = qtTrId("main_imageFreshness_fresh");
+        break;
+    case LinboImage::Stale:
+        //% "The server has a newer image, the next sync will download it"
+        freshness = qtTrId("main_imageFreshness_stale");
+        break;
+    case LinboImage::Missing:
+        //% "The image is not in the cache yet"
+        freshness = qtTrId("main_imageFreshness_missing");
+        break;
+    default:
+        break;
+    }
+
+    if(freshness.isEmpty())
+        this->setToolTip(this->_os->description());
+    else
+        this->setToolTip(this->_os->description() + "\n" + freshness);
+
+    this->update();
+}
+
 LinboOs* LinboOsSelectButton::_getOs() {
     return this->_os;
 }
@@ -368,7 +418,8 @@ void LinboOsSelectButton::_updateActionButtonVisibility(bool doNotAnimate) {
                            state == LinboBackend::Syncing ||
                            state == LinboBackend::Reinstalling ||
                            state == LinboBackend::CreatingImage ||
-                           state == LinboBackend::UploadingImage);
+                           state == LinboBackend::UploadingImage ||
+                           state == LinboBackend::SyncingOs);
 
     bool startVisible = this->_shouldBeVisible && state < LinboBackend::Root && !isActiveAction;
     bool rootVisible = this->_shouldBeVisible && state >= LinboBackend::Root && !isActiveAction;
@@ -263,6 +263,7 @@ void LinboOsSelectionRow::_handleLinboStateChanged(LinboBackend::LinboState newS
     case LinboBackend::Reinstalling:
     case LinboBackend::CreatingImage:
     case LinboBackend::UploadingImage:
+    case LinboBackend::SyncingOs:
     case LinboBackend::StartActionError:
         buttonsEnabled = false;
         showOnlyButtonOfOsOfCurrentAction = true;
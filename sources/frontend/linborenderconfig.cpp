@@ -0,0 +1,79 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linborenderconfig.h"
+
+int LinboRenderConfig::_framebufferDepth = 0;
+bool LinboRenderConfig::_enabled = true;
+
+int LinboRenderConfig::framebufferDepth() {
+    if(_framebufferDepth == 0) {
+        QScreen* screen = QGuiApplication::primaryScreen();
+        _framebufferDepth = screen == nullptr ? 32 : screen->depth();
+    }
+
+    return _framebufferDepth;
+}
+
+QImage::Format LinboRenderConfig::opaqueFormat() {
+    return framebufferDepth() == 16 ? QImage::Format_RGB16 : QImage::Format_RGB32;
+}
+
+QImage::Format LinboRenderConfig::translucentFormat() {
+    // the backing store of the raster engine uses these on 16 and 32 bit screens
+    return framebufferDepth() == 16 ? QImage::Format_ARGB8565_Premultiplied : QImage::Format_ARGB32_Premultiplied;
+}
+
+QImage LinboRenderConfig::toOpaqueFormat(const QImage& image) {
+    if(!_enabled || image.format() == opaqueFormat())
+        return image;
+
+    // dithering hides the banding of dark gradients on 16 bit framebuffers
+    return image.convertToFormat(opaqueFormat(), Qt::DiffuseDither);
+}
+
+QImage LinboRenderConfig::toTranslucentFormat(const QImage& image) {
+    if(!_enabled)
+        return image;
+
+    if(!image.hasAlphaChannel())
+        return toOpaqueFormat(image);
+
+    if(image.format() == translucentFormat())
+        return image;
+
+    return image.convertToFormat(translucentFormat());
+}
+
+void LinboRenderConfig::setOpaque(QWidget* widget) {
+    if(!_enabled)
+        return;
+
+    // the widget paints every pixel it covers, nothing below it has to be painted first
+    widget->setAttribute(Qt::WA_TranslucentBackground, false);
+    widget->setAttribute(Qt::WA_OpaquePaintEvent, true);
+    widget->setAttribute(Qt::WA_NoSystemBackground, true);
+}
+
+void LinboRenderConfig::setEnabled(bool enabled) {
+    _enabled = enabled;
+}
+
+bool LinboRenderConfig::isEnabled() {
+    return _enabled;
+}
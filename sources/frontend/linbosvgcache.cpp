@@ -0,0 +1,288 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbosvgcache.h"
+
+QHash<QString, QSvgRenderer*> LinboSvgCache::_renderers;
+QCache<QString, QPixmap> LinboSvgCache::_pixmaps(LinboSvgCache::_maxCacheBytes);
+bool LinboSvgCache::_atlasLoaded = false;
+QHash<int, QImage> LinboSvgCache::_atlases;
+QHash<QString, QRect> LinboSvgCache::_atlasIndex;
+QString LinboSvgCache::_diskCacheDirectory;
+QHash<QString, QString> LinboSvgCache::_diskCacheSources;
+QHash<QString, QImage> LinboSvgCache::_diskCacheWrites;
+qint64 LinboSvgCache::_diskCacheWriteBytes = 0;
+
+QPixmap LinboSvgCache::pixmap(const QString& path, QSize size, const QColor& tint, Qt::AspectRatioMode aspectRatioMode, qreal devicePixelRatio) {
+    if(size.isEmpty())
+        return QPixmap();
+
+    QString key = path
+                  + "|" + QString::number(size.width()) + "x" + QString::number(size.height())
+                  + "|" + (tint.isValid() ? tint.name(QColor::HexArgb) : "")
+                  + "|" + QString::number(aspectRatioMode)
+                  + "|" + QString::number(devicePixelRatio);
+
+    QPixmap* cachedPixmap = _pixmaps.object(key);
+    if(cachedPixmap != nullptr)
+        return *cachedPixmap;
+
+    // the atlas only contains untinted, square icons without scaling
+    if(!tint.isValid() && aspectRatioMode == Qt::IgnoreAspectRatio && devicePixelRatio == 1) {
+        QPixmap atlasPixmap = _pixmapFromAtlas(path, size);
+        if(!atlasPixmap.isNull()) {
+            _pixmaps.insert(key, new QPixmap(atlasPixmap), qMax(1, atlasPixmap.width() * atlasPixmap.height() * 4));
+            return atlasPixmap;
+        }
+    }
+
+    QString diskCacheFileName = _diskCacheFileName(path, key);
+    if(!diskCacheFileName.isEmpty() && !_diskCacheDirectory.isEmpty()) {
+        QImage diskImage(_diskCacheDirectory + "/" + diskCacheFileName);
+        if(!diskImage.isNull() && diskImage.size() == size * devicePixelRatio) {
+            QPixmap* pixmap = new QPixmap(QPixmap::fromImage(LinboRenderConfig::toTranslucentFormat(diskImage)));
+            pixmap->setDevicePixelRatio(devicePixelRatio);
+            QPixmap result = *pixmap;
+            _pixmaps.insert(key, pixmap, qMax(1, pixmap->width() * pixmap->height() * 4));
+            return result;
+        }
+    }
+
+    QSvgRenderer* renderer = _renderer(path);
+    if(renderer == nullptr)
+        return QPixmap();
+
+    QPixmap* pixmap = new QPixmap(size * devicePixelRatio);
+    pixmap->setDevicePixelRatio(devicePixelRatio);
+    pixmap->fill(Qt::transparent);
+
+    QRectF targetRect(QPointF(0, 0), size);
+    if(aspectRatioMode != Qt::IgnoreAspectRatio) {
+        QSizeF scaledSize = QSizeF(renderer->defaultSize()).scaled(size, aspectRatioMode);
+        targetRect = QRectF(
+            QPointF((size.width() - scaledSize.width()) / 2, (size.height() - scaledSize.height()) / 2),
+            scaledSize
+        );
+    }
+
+    QPainter painter(pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    renderer->render(&painter, targetRect);
+
+    if(tint.isValid()) {
+        // keeps the shape, replaces the colors
+        painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+        painter.fillRect(QRectF(QPointF(0, 0), size), tint);
+    }
+    painter.end();
+
+    if(!diskCacheFileName.isEmpty()) {
+        // without an open disk cache, there might never be one to write to
+        qint64 bytes = qint64(pixmap->width()) * pixmap->height() * 4;
+        if(!_diskCacheDirectory.isEmpty() || _diskCacheWriteBytes + bytes <= _maxPendingWriteBytes) {
+            _diskCacheWrites.insert(diskCacheFileName, pixmap->toImage());
+            _diskCacheWriteBytes += bytes;
+        }
+    }
+
+    QPixmap result = *pixmap;
+    _pixmaps.insert(key, pixmap, qMax(1, pixmap->width() * pixmap->height() * 4));
+    return result;
+}
+
+void LinboSvgCache::paint(QPainter* painter, const QRectF& rect, const QString& path, const QColor& tint, Qt::AspectRatioMode aspectRatioMode) {
+    QRect alignedRect = rect.toAlignedRect();
+    qreal devicePixelRatio = painter->device() != nullptr ? painter->device()->devicePixelRatioF() : 1;
+    QPixmap pixmap = LinboSvgCache::pixmap(path, alignedRect.size(), tint, aspectRatioMode, devicePixelRatio);
+    if(!pixmap.isNull())
+        painter->drawPixmap(alignedRect.topLeft(), pixmap);
+}
+
+QSize LinboSvgCache::defaultSize(const QString& path) {
+    QSvgRenderer* renderer = _renderer(path);
+    return renderer == nullptr ? QSize() : renderer->defaultSize();
+}
+
+bool LinboSvgCache::isValid(const QString& path) {
+    return _renderer(path) != nullptr;
+}
+
+void LinboSvgCache::clear() {
+    _pixmaps.clear();
+    qDeleteAll(_renderers);
+    _renderers.clear();
+    _atlases.clear();
+    _atlasIndex.clear();
+    _atlasLoaded = false;
+    _diskCacheSources.clear();
+    _clearDiskCacheWrites();
+}
+
+void LinboSvgCache::releaseAtlas() {
+    // the index is kept, an image is decoded again if its size is needed later
+    _atlases.clear();
+}
+
+void LinboSvgCache::openDiskCache(const QString& directory) {
+    if(directory.isEmpty() || !QDir().mkpath(directory))
+        return;
+
+    _diskCacheDirectory = directory;
+}
+
+void LinboSvgCache::closeDiskCache(bool persist) {
+    if(!persist) {
+        _diskCacheDirectory.clear();
+        _diskCacheSources.clear();
+        _clearDiskCacheWrites();
+        return;
+    }
+
+    // kept for the next disk cache that is opened
+    if(_diskCacheDirectory.isEmpty())
+        return;
+
+    QDir directory(_diskCacheDirectory);
+
+    // write to a temporary file first, an interrupted boot must not leave a truncated png behind
+    for(auto write = _diskCacheWrites.constBegin(); write != _diskCacheWrites.constEnd(); write++) {
+        QString filePath = directory.filePath(write.key());
+        QString temporaryPath = filePath + ".tmp";
+        if(write.value().save(temporaryPath, "PNG"))
+            QFile::rename(temporaryPath, filePath);
+        else
+            QFile::remove(temporaryPath);
+    }
+
+    // entries of an older version of a file that was used during this boot are stale
+    for(const QString& source : _diskCacheSources) {
+        if(source.isEmpty())
+            continue;
+
+        QString pathHash = source.section("-", 0, 0);
+        for(const QString& fileName : directory.entryList({pathHash + "-*"}, QDir::Files)) {
+            if(!fileName.startsWith(source + "-"))
+                directory.remove(fileName);
+        }
+    }
+
+    _diskCacheDirectory.clear();
+    _diskCacheSources.clear();
+    _clearDiskCacheWrites();
+}
+
+bool LinboSvgCache::hasPendingDiskCacheWrites() {
+    return !_diskCacheWrites.isEmpty();
+}
+
+QSvgRenderer* LinboSvgCache::_renderer(const QString& path) {
+    if(_renderers.contains(path))
+        return _renderers.value(path);
+
+    // pixmaps must not outlive the application
+    if(_renderers.isEmpty())
+        qAddPostRoutine(LinboSvgCache::clear);
+
+    // invalid files are remembered as well, so they are not parsed again
+    QSvgRenderer* renderer = new QSvgRenderer(path);
+    if(!renderer->isValid()) {
+        delete renderer;
+        renderer = nullptr;
+    }
+
+    _renderers.insert(path, renderer);
+    return renderer;
+}
+
+void LinboSvgCache::_loadAtlas() {
+    _atlasLoaded = true;
+    qAddPostRoutine(LinboSvgCache::clear);
+
+    // not there when the gui was built without the atlas
+    QFile indexFile(":/iconatlas/atlas.index");
+    if(!indexFile.open(QFile::ReadOnly))
+        return;
+
+    QTextStream index(&indexFile);
+    while(!index.atEnd()) {
+        // <path> <size> <x> <y>
+        QStringList entry = index.readLine().split(" ", Qt::SkipEmptyParts);
+        if(entry.length() != 4)
+            continue;
+
+        int size = entry.at(1).toInt();
+        _atlasIndex.insert(entry.at(0) + "|" + entry.at(1), QRect(entry.at(2).toInt(), entry.at(3).toInt(), size, size));
+    }
+}
+
+const QImage& LinboSvgCache::_atlasOfSize(int size) {
+    auto atlas = _atlases.find(size);
+    if(atlas == _atlases.end()) {
+        // converted once, not on every copy
+        QImage image(":/iconatlas/atlas-" + QString::number(size) + ".png");
+        atlas = _atlases.insert(size, LinboRenderConfig::toTranslucentFormat(image));
+    }
+    return atlas.value();
+}
+
+QPixmap LinboSvgCache::_pixmapFromAtlas(const QString& path, QSize size) {
+    if(size.width() != size.height() || !path.startsWith(":/"))
+        return QPixmap();
+
+    if(!_atlasLoaded)
+        _loadAtlas();
+
+    QString key = path + "|" + QString::number(size.width());
+    if(!_atlasIndex.contains(key))
+        return QPixmap();
+
+    const QImage& atlas = _atlasOfSize(size.width());
+    if(atlas.isNull())
+        return QPixmap();
+
+    return QPixmap::fromImage(atlas.copy(_atlasIndex.value(key)));
+}
+
+QString LinboSvgCache::_diskCacheFileName(const QString& path, const QString& key) {
+    // the bundled icons are in the binary already
+    if(path.startsWith(":/"))
+        return "";
+
+    // every file is read and hashed only once per boot
+    if(!_diskCacheSources.contains(path)) {
+        QFile file(path);
+        QString source;
+        if(file.open(QFile::ReadOnly)) {
+            source = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Sha1).toHex().left(16)
+                     + "-" + QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1).toHex();
+        }
+        _diskCacheSources.insert(path, source);
+    }
+
+    QString source = _diskCacheSources.value(path);
+    if(source.isEmpty())
+        return "";
+
+    QString variant = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    return source + "-" + variant + ".png";
+}
+
+void LinboSvgCache::_clearDiskCacheWrites() {
+    _diskCacheWrites.clear();
+    _diskCacheWriteBytes = 0;
+}
@@ -0,0 +1,636 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "linbocli.h"
+
+#include <limits>
+#include <algorithm>
+#include <cstdio>
+
+LinboCli::LinboCli(QObject *parent) : QObject(parent), _out(stdout), _err(stderr)
+{
+}
+
+bool LinboCli::isCliInvocation(int argc, char* argv[]) {
+    for(int i = 1; i < argc; i++) {
+        if(_modeOptions.contains(QString::fromLocal8Bit(argv[i])))
+            return true;
+    }
+    return false;
+}
+
+int LinboCli::exec(const QStringList& arguments) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Modern Linbo GUI");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"log-archive-list", "List the segments of the log archive on the cache partition."},
+        {"log-archive-read", "Print the decompressed segments of the log archive."},
+        {"archive-dir", "Directory of the log archive (default: <cache>/linbo-log).", "directory"},
+        {"log-export", "Filter a structured log (eg. /tmp/linbo.log.bin) and print it as text or json.", "file"},
+        {"format", "Output format of --log-export: text or json (default: text).", "format"},
+        {"types", "Only include these log types (comma separated: stdout,stderr,info,error,chapter).", "types"},
+        {"chapter", "Only include logs of this chapter.", "id"},
+        {"state", "Only include logs emitted in this LINBO state.", "state"},
+        {"command", "Only include logs of this linbo_cmd command (eg. syncstart).", "command"},
+        {"log-benchmark", "Measure the GUI thread time spent logging stdout lines with the sinks configured in the environment (LINBO_LOG_*)."},
+        {"lines", "Number of lines to log for --log-benchmark (default: 100000).", "count"},
+        {"autostart-simulation", "Simulate a room of clients syncing against a bandwidth limited server to tune AutostartJitter and AutostartWindow."},
+        {"clients", "Number of clients for --autostart-simulation (default: 30).", "count"},
+        {"server-bandwidth", "Bandwidth of the server in MBit/s (default: 1000).", "mbit"},
+        {"client-bandwidth", "Bandwidth of each client in MBit/s (default: 1000).", "mbit"},
+        {"transfer", "Data each client downloads in MB (default: 4000).", "mb"},
+        {"jitter", "AutostartJitter in seconds (default: compare 0, 60, 120, 300 and 600).", "seconds"},
+        {"window", "AutostartWindow in seconds (default: 0).", "seconds"},
+        {"headless", "Run an action of the backend without the user interface and print its progress."},
+        {"exec", "Action for --headless: start:<os>, sync:<os>, reinstall:<os>, create:<os>, create-diff:<os>, upload:<os>, initcache[:rsync|multicast|torrent], initcache-format[:<method>] or partition.", "action"},
+        {"jobs", "Comma separated jobs for --headless, run one after another instead of --exec: create-base:<os>, create-diff:<os>, upload:<os>[:<image>], sync:<os>, initcache[:rsync|multicast|torrent] or partition.", "jobs"},
+        {"pipelined", "Let the --jobs overlap which do not use the same resources (disk or network)."},
+        {"then", "Comma separated actions after --exec or --jobs: upload (only after --exec), logout, reboot or shutdown.", "actions"},
+        {"password-stdin", "Read the password for root actions of --headless from the first line of stdin instead of $LINBO_PASSWORD."},
+        {"from", "Only include logs newer than this (ISO 8601).", "time"},
+        {"to", "Only include logs older than this (ISO 8601).", "time"},
+    });
+    parser.process(arguments);
+
+    if(parser.isSet("log-archive-list"))
+        return this->_listLogArchive(parser);
+    else if(parser.isSet("log-archive-read"))
+        return this->_readLogArchive(parser);
+    else if(parser.isSet("log-export"))
+        return this->_exportStructuredLog(parser);
+    else if(parser.isSet("log-benchmark"))
+        return this->_benchmarkLogger(parser);
+    else if(parser.isSet("autostart-simulation"))
+        return this->_simulateAutostart(parser);
+    else if(parser.isSet("headless"))
+        return this->_runHeadless(parser);
+
+    parser.showHelp(1);
+}
+
+// -- Log archive --
+
+int LinboCli::_listLogArchive(const QCommandLineParser& parser) {
+    QDateTime from, to;
+    if(!this->_parseTime(parser, "from", &from) || !this->_parseTime(parser, "to", &to))
+        return 1;
+
+    for(const LinboLogArchive::Segment& segment : LinboLogArchive::segments(this->_logArchiveDirectory(parser), from, to)) {
+        this->_out << segment.begin.toString(Qt::ISODate) << "  "
+                   << segment.end.toString(Qt::ISODate) << "  "
+                   << QString::number(segment.size).rightJustified(8) << "  "
+                   << segment.path << "\n";
+    }
+
+    this->_out.flush();
+    return 0;
+}
+
+int LinboCli::_readLogArchive(const QCommandLineParser& parser) {
+    QDateTime from, to;
+    if(!this->_parseTime(parser, "from", &from) || !this->_parseTime(parser, "to", &to))
+        return 1;
+
+    for(const LinboLogArchive::Segment& segment : LinboLogArchive::segments(this->_logArchiveDirectory(parser), from, to)) {
+        this->_out << "===== " << segment.path << " =====\n";
+        this->_out << QString::fromUtf8(LinboLogArchive::readSegment(segment.path));
+        this->_out.flush();
+    }
+
+    return 0;
+}
+
+// -- Structured log --
+
+int LinboCli::_exportStructuredLog(const QCommandLineParser& parser) {
+    QDateTime from, to;
+    if(!this->_parseTime(parser, "from", &from) || !this->_parseTime(parser, "to", &to))
+        return 1;
+
+    bool typesOk = true;
+    LinboLogger::LinboLogTypes types = parser.isSet("types") ? LinboLogger::stringToLogTypes(parser.value("types"), &typesOk) : LinboLogger::stringToLogTypes("all");
+    QString format = parser.isSet("format") ? parser.value("format") : "text";
+    if(!typesOk || (format != "text" && format != "json")) {
+        this->_err << "Invalid --types or --format\n";
+        this->_err.flush();
+        return 1;
+    }
+
+    bool filterChapter = parser.isSet("chapter");
+    quint32 chapter = parser.value("chapter").toUInt();
+    bool filterState = parser.isSet("state");
+    int state = parser.value("state").toInt();
+    bool filterCommand = parser.isSet("command");
+    QString command = parser.value("command");
+    qint64 fromMs = from.isValid() ? from.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+    qint64 toMs = to.isValid() ? to.toMSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+    bool json = format == "json";
+
+    LinboStructuredLog::Reader reader(parser.value("log-export"));
+    if(!reader.open()) {
+        this->_err << "Could not open structured log: " << parser.value("log-export") << "\n";
+        this->_err.flush();
+        return 1;
+    }
+
+    QByteArray output;
+    output.reserve(2 * 1024 * 1024);
+    qint64 lastSecond = std::numeric_limits<qint64>::min();
+    QByteArray lastSecondString;
+
+    LinboStructuredLog::RecordHeader header;
+    QString recordCommand, recordMessage;
+    while(reader.readHeader(&header)) {
+        // filter on the header first, so we don't have to decode the strings of skipped records
+        if(!types.testFlag((LinboLogger::LinboLogType)header.type)
+                || header.wallClockMs < fromMs || header.wallClockMs > toMs
+                || (filterChapter && header.chapter != chapter)
+                || (filterState && header.state != state)) {
+            reader.skipStrings(header);
+            continue;
+        }
+
+        reader.readStrings(header, &recordCommand, &recordMessage);
+        if(filterCommand && recordCommand != command)
+            continue;
+
+        // formatting a QDateTime is expensive, only do it once per second
+        qint64 second = header.wallClockMs / 1000;
+        if(second != lastSecond) {
+            lastSecond = second;
+            lastSecondString = QDateTime::fromSecsSinceEpoch(second).toString("yyyy-MM-dd'T'HH:mm:ss").toUtf8();
+        }
+        QByteArray milliseconds = QByteArray::number(header.wallClockMs % 1000).rightJustified(3, '0');
+
+        if(json) {
+            output += "{\"time\":\"" + lastSecondString + "." + milliseconds + "\"";
+            output += ",\"monotonicNs\":" + QByteArray::number(header.monotonicNs);
+            output += ",\"type\":\"" + _structuredLogTypeName(header.type) + "\"";
+            output += ",\"chapter\":" + QByteArray::number(header.chapter);
+            output += ",\"state\":" + QByteArray::number(header.state);
+            output += ",\"command\":";
+            _appendJsonString(output, recordCommand);
+            output += ",\"message\":";
+            _appendJsonString(output, recordMessage);
+            output += "}\n";
+        }
+        else {
+            output += lastSecondString + "." + milliseconds;
+            output += " #" + QByteArray::number(header.chapter);
+            output += " [" + _structuredLogTypeName(header.type) + "]";
+            if(!recordCommand.isEmpty())
+                output += " (" + recordCommand.toUtf8() + ")";
+            output += " " + recordMessage.toUtf8() + "\n";
+        }
+
+        if(output.size() >= 1024 * 1024) {
+            fwrite(output.constData(), 1, output.size(), stdout);
+            output.clear();
+        }
+    }
+
+    fwrite(output.constData(), 1, output.size(), stdout);
+    fflush(stdout);
+    return 0;
+}
+
+// -- Logger benchmark --
+
+int LinboCli::_benchmarkLogger(const QCommandLineParser& parser) {
+    int lineCount = parser.isSet("lines") ? parser.value("lines").toInt() : 100000;
+    if(lineCount <= 0)
+        lineCount = 100000;
+
+    // something that looks like rsync output, prepared upfront so only the logger is measured
+    QStringList lines;
+    for(int i = 0; i < 100; i++)
+        lines.append("ubuntu.qcow2   " + QString::number(1234567890 + i * 4096) + "  " + QString::number(i) + "%  112.34MB/s    0:00:" + QString::number(i % 60).rightJustified(2, '0'));
+
+    QString logFilePath = "/tmp/linbo-log-benchmark.log";
+    QFile::remove(logFilePath);
+    QFile::remove(logFilePath + ".bin");
+
+    LinboLogger* logger = new LinboLogger(logFilePath, this);
+    for(int sink = 0; sink < LinboLogger::LogSinkCount; sink++)
+        this->_out << LinboLogger::logSinkToString((LinboLogger::LinboLogSink)sink) << ": "
+                   << LinboLogger::logTypesToString(logger->sinkLogTypes((LinboLogger::LinboLogSink)sink)) << "\n";
+    this->_out.flush();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    logger->chapterBeginning("Benchmark");
+    for(int i = 0; i < lineCount; i++)
+        logger->stdOut(lines[i % lines.length()]);
+    logger->chapterEnd("Benchmark finished");
+
+    qint64 guiThreadNs = timer.nsecsElapsed();
+    logger->flush();
+    qint64 totalNs = timer.nsecsElapsed();
+
+    delete logger;
+    QFile::remove(logFilePath);
+    QFile::remove(logFilePath + ".bin");
+
+    this->_out << "Logged " << lineCount << " stdout lines\n"
+               << "GUI thread: " << QString::number(guiThreadNs / 1e6, 'f', 2) << " ms ("
+               << QString::number(guiThreadNs / 1e6 / lineCount * 10000, 'f', 3) << " ms per 10,000 lines)\n"
+               << "Including the writer thread flush: " << QString::number(totalNs / 1e6, 'f', 2) << " ms\n";
+    this->_out.flush();
+
+    return 0;
+}
+
+// -- Headless --
+
+int LinboCli::_runHeadless(const QCommandLineParser& parser) {
+    LinboPostProcessActions::Flags postProcessActions = LinboPostProcessActions::NoAction;
+    if(parser.isSet("exec") == parser.isSet("jobs") || !_parsePostProcessActions(parser.value("then"), &postProcessActions)) {
+        this->_err << "--headless needs either --exec <action> or --jobs <jobs> and --then only accepts upload, logout, reboot and shutdown\n";
+        this->_err.flush();
+        return 1;
+    }
+
+    // never from the command line, everybody can read that in /proc/<pid>/cmdline
+    QString password = qEnvironmentVariable("LINBO_PASSWORD");
+    if(parser.isSet("password-stdin"))
+        password = QTextStream(stdin).readLine();
+
+    LinboBackend* backend = new LinboBackend(this, false);
+
+    QElapsedTimer timer;
+    timer.start();
+    bool actionStarted = false;
+    int exitCode = -1;
+
+    // every log line of linbo_cmd and every state change, prefixed with the seconds since the start
+    auto timestamp = [&]() {
+        return "[" + QString::number(timer.elapsed() / 1000.0, 'f', 1).rightJustified(7) + "] ";
+    };
+    connect(backend->logger(), &LinboLogger::latestLogChanged, this, [&](const LinboLogger::LinboLog& latestLog) {
+        if(latestLog.message.isEmpty())
+            return;
+        QTextStream& stream = latestLog.type == LinboLogger::StdErr || latestLog.type == LinboLogger::LinboGuiError ? this->_err : this->_out;
+        stream << timestamp() << latestLog.message << "\n";
+        stream.flush();
+    });
+    connect(backend, &LinboBackend::stateChanged, this, [&](LinboBackend::LinboState state) {
+        this->_out << timestamp() << "state: " << QMetaEnum::fromType<LinboBackend::LinboState>().valueToKey(state) << "\n";
+        this->_out.flush();
+
+        switch (state) {
+        case LinboBackend::Idle:
+        case LinboBackend::Root:
+            // back where the action started from, eg. after a logout
+            if(actionStarted)
+                exitCode = 0;
+            break;
+        case LinboBackend::RootActionSuccess:
+            exitCode = 0;
+            break;
+        case LinboBackend::StartActionError:
+        case LinboBackend::RootActionError:
+            exitCode = 1;
+            break;
+        default:
+            actionStarted = true;
+            break;
+        }
+
+        if(exitCode >= 0)
+            QCoreApplication::exit(exitCode);
+    });
+
+    QString action = parser.isSet("jobs") ? parser.value("jobs") : parser.value("exec");
+    bool started = parser.isSet("jobs") ?
+                       this->_startHeadlessJobs(backend, action, parser.isSet("pipelined"), postProcessActions, password) :
+                       this->_startHeadlessAction(backend, action, postProcessActions, password);
+    if(!started) {
+        this->_err << "Could not start " << action << " in state "
+                   << QMetaEnum::fromType<LinboBackend::LinboState>().valueToKey(backend->state()) << "\n";
+        this->_err.flush();
+        backend->disconnect(this);
+        backend->logger()->disconnect(this);
+        return 1;
+    }
+
+    // the action might have failed right away
+    if(exitCode < 0)
+        exitCode = QCoreApplication::exec();
+
+    // the handlers capture locals of this function
+    backend->disconnect(this);
+    backend->logger()->disconnect(this);
+
+    this->_out << timestamp() << "finished with exit code " << exitCode << "\n";
+    this->_out.flush();
+    return exitCode;
+}
+
+bool LinboCli::_startHeadlessAction(LinboBackend* backend, QString action, LinboPostProcessActions::Flags postProcessActions, QString password) {
+    QString verb = action.section(":", 0, 0);
+    QString argument = action.section(":", 1);
+
+    if(verb == "start" || verb == "sync" || verb == "reinstall") {
+        LinboOs* os = _findOs(backend, argument);
+        if(os == nullptr)
+            return false;
+        if(verb == "start")
+            return os->executeStart();
+        else if(verb == "sync")
+            return os->executeSync();
+        return os->executeReinstall();
+    }
+
+    // everything else is a root action
+    if(!backend->login(password))
+        return false;
+
+    if(verb == "create" || verb == "create-diff") {
+        LinboOs* os = _findOs(backend, argument);
+        if(os == nullptr)
+            return false;
+        if(verb == "create")
+            return os->createBaseImage("", postProcessActions);
+        return os->createDiffImage("", postProcessActions);
+    }
+    else if(verb == "upload") {
+        LinboOs* os = _findOs(backend, argument);
+        if(os == nullptr || os->baseImage() == nullptr)
+            return false;
+        return os->baseImage()->upload(postProcessActions);
+    }
+    else if(verb == "initcache" || verb == "initcache-format") {
+        LinboConfig::DownloadMethod downloadMethod = argument.isEmpty() ? backend->config()->downloadMethod() : LinboConfig::stringToDownloadMethod(argument);
+        return backend->updateCache(downloadMethod, verb == "initcache-format", postProcessActions);
+    }
+    else if(verb == "partition") {
+        return backend->partitionDrive();
+    }
+
+    return false;
+}
+
+bool LinboCli::_startHeadlessJobs(LinboBackend* backend, QString jobs, bool pipelined, LinboPostProcessActions::Flags postProcessActions, QString password) {
+    if(!backend->login(password))
+        return false;
+
+    LinboJobQueue* jobQueue = backend->jobQueue();
+    jobQueue->clear();
+    for(const QString& jobString : jobs.split(",", Qt::SkipEmptyParts)) {
+        LinboJob* job = _parseJob(backend, jobString);
+        if(job == nullptr) {
+            this->_err << "Invalid job: " << jobString << "\n";
+            this->_err.flush();
+            jobQueue->clear();
+            return false;
+        }
+        jobQueue->append(job);
+    }
+
+    // the queue only runs the actions after the last job and only when every job succeeded
+    jobQueue->setPostProcessActions(postProcessActions);
+    jobQueue->setPipelined(pipelined);
+    return jobQueue->start();
+}
+
+LinboJob* LinboCli::_parseJob(LinboBackend* backend, QString job) {
+    bool typeOk = false;
+    LinboJob::JobType type = LinboJob::stringToType(job.section(":", 0, 0), &typeOk);
+    QString argument = job.section(":", 1, 1);
+    if(!typeOk)
+        return nullptr;
+
+    if(type == LinboJob::InitCacheJob) {
+        LinboJob* initCacheJob = new LinboJob(type);
+        if(!argument.isEmpty())
+            initCacheJob->setDownloadMethod(LinboConfig::stringToDownloadMethod(argument));
+        return initCacheJob;
+    }
+    else if(type == LinboJob::PartitionDriveJob) {
+        // like --exec partition
+        LinboJob* partitionJob = new LinboJob(type);
+        partitionJob->setFormat(true);
+        return partitionJob;
+    }
+
+    LinboOs* os = _findOs(backend, argument);
+    if(os == nullptr || os->baseImage() == nullptr)
+        return nullptr;
+
+    LinboJob* osJob = new LinboJob(type, os);
+    if(type == LinboJob::UploadImageJob && !job.section(":", 2).isEmpty())
+        osJob->setImageName(job.section(":", 2));
+    return osJob;
+}
+
+bool LinboCli::_parsePostProcessActions(QString actions, LinboPostProcessActions::Flags* postProcessActions) {
+    for(const QString& action : actions.split(",", Qt::SkipEmptyParts)) {
+        if(action == "upload")
+            *postProcessActions |= LinboPostProcessActions::UploadImage;
+        else if(action == "logout")
+            *postProcessActions |= LinboPostProcessActions::Logout;
+        else if(action == "reboot")
+            *postProcessActions |= LinboPostProcessActions::Reboot;
+        else if(action == "shutdown")
+            *postProcessActions |= LinboPostProcessActions::Shutdown;
+        else
+            return false;
+    }
+    return true;
+}
+
+LinboOs* LinboCli::_findOs(LinboBackend* backend, QString name) {
+    for(LinboOs* os : backend->config()->operatingSystems())
+        if(os->name().compare(name, Qt::CaseInsensitive) == 0)
+            return os;
+    return nullptr;
+}
+
+// -- Autostart simulation --
+
+int LinboCli::_simulateAutostart(const QCommandLineParser& parser) {
+    int clients = parser.isSet("clients") ? parser.value("clients").toInt() : 30;
+    double serverBandwidth = (parser.isSet("server-bandwidth") ? parser.value("server-bandwidth").toDouble() : 1000) / 8;
+    double clientBandwidth = (parser.isSet("client-bandwidth") ? parser.value("client-bandwidth").toDouble() : 1000) / 8;
+    double transferSize = parser.isSet("transfer") ? parser.value("transfer").toDouble() : 4000;
+    int window = parser.isSet("window") ? parser.value("window").toInt() : 0;
+    QList<int> jitters = {0, 60, 120, 300, 600};
+    if(parser.isSet("jitter"))
+        jitters = {parser.value("jitter").toInt()};
+
+    if(clients <= 0 || serverBandwidth <= 0 || clientBandwidth <= 0 || transferSize <= 0) {
+        this->_err << "Invalid --clients, --server-bandwidth, --client-bandwidth or --transfer\n";
+        this->_err.flush();
+        return 1;
+    }
+
+    this->_out << clients << " clients, server " << serverBandwidth * 8 << " MBit/s, client " << clientBandwidth * 8
+               << " MBit/s, " << transferSize << " MB each, window " << window << "s\n\n"
+               << "jitter  peak clients  first done  mean done  last done  mean MB/s per client\n";
+
+    for(int jitter : jitters) {
+        // the same MAC addresses for every jitter, the delays come from the code the backend uses
+        QList<double> startSeconds;
+        for(int i = 0; i < clients; i++) {
+            QString macAddress = QString("00:16:3e:%1:%2:%3")
+                                     .arg((i >> 16) & 0xff, 2, 16, QLatin1Char('0'))
+                                     .arg((i >> 8) & 0xff, 2, 16, QLatin1Char('0'))
+                                     .arg(i & 0xff, 2, 16, QLatin1Char('0'));
+            startSeconds.append(LinboStartJitter::delayMilliseconds(macAddress, jitter, window) / 1000.0);
+        }
+
+        int peakConcurrency = 0;
+        QList<double> finishSeconds = _simulateTransfers(startSeconds, serverBandwidth, clientBandwidth, transferSize, &peakConcurrency);
+
+        double first = std::numeric_limits<double>::max(), last = 0, finishSum = 0, throughputSum = 0;
+        for(int i = 0; i < clients; i++) {
+            first = qMin(first, finishSeconds[i]);
+            last = qMax(last, finishSeconds[i]);
+            finishSum += finishSeconds[i];
+            throughputSum += transferSize / (finishSeconds[i] - startSeconds[i]);
+        }
+
+        this->_out << QString::number(jitter).rightJustified(5) << "s"
+                   << QString::number(peakConcurrency).rightJustified(14)
+                   << QString::number(first, 'f', 0).rightJustified(11) << "s"
+                   << QString::number(finishSum / clients, 'f', 0).rightJustified(10) << "s"
+                   << QString::number(last, 'f', 0).rightJustified(10) << "s"
+                   << QString::number(throughputSum / clients, 'f', 1).rightJustified(22) << "\n";
+    }
+
+    this->_out.flush();
+    return 0;
+}
+
+QList<double> LinboCli::_simulateTransfers(QList<double> startSeconds, double serverBandwidth, double clientBandwidth, double transferSize, int* peakConcurrency) {
+    // The server shares its bandwidth equally between all active clients, no client gets more than its own link
+    int count = startSeconds.length();
+    QList<int> order;
+    for(int i = 0; i < count; i++)
+        order.append(i);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return startSeconds[a] < startSeconds[b];
+    });
+
+    QList<double> remaining(count, transferSize);
+    QList<double> finishSeconds(count, 0);
+    QList<int> active;
+    int nextArrival = 0;
+    double now = 0;
+    *peakConcurrency = 0;
+
+    while(nextArrival < count || !active.isEmpty()) {
+        double rate = active.isEmpty() ? 0 : qMin(clientBandwidth, serverBandwidth / active.length());
+
+        double nextEvent = nextArrival < count ? startSeconds[order[nextArrival]] : std::numeric_limits<double>::max();
+        for(int client : active)
+            nextEvent = qMin(nextEvent, now + remaining[client] / rate);
+
+        for(int client : active)
+            remaining[client] -= rate * (nextEvent - now);
+        now = nextEvent;
+
+        for(int i = active.length() - 1; i >= 0; i--) {
+            if(remaining[active[i]] > 1e-6)
+                continue;
+            finishSeconds[active[i]] = now;
+            active.removeAt(i);
+        }
+
+        while(nextArrival < count && startSeconds[order[nextArrival]] <= now)
+            active.append(order[nextArrival++]);
+
+        *peakConcurrency = qMax(*peakConcurrency, int(active.length()));
+    }
+
+    return finishSeconds;
+}
+
+// -----------
+// - Helpers -
+// -----------
+
+QByteArray LinboCli::_structuredLogTypeName(qint8 type) {
+    switch (type) {
+    case LinboLogger::StdOut:
+        return "stdout";
+    case LinboLogger::StdErr:
+        return "stderr";
+    case LinboLogger::LinboGuiInfo:
+        return "info";
+    case LinboLogger::LinboGuiError:
+        return "error";
+    case LinboLogger::LinboLogChapterBeginning:
+        return "chapterBeginning";
+    case LinboLogger::LinboLogChapterEnd:
+        return "chapterEnd";
+    default:
+        return "unknown";
+    }
+}
+
+void LinboCli::_appendJsonString(QByteArray& output, const QString& string) {
+    output += '"';
+    for(const char character : string.toUtf8()) {
+        switch (character) {
+        case '"':
+            output += "\\\"";
+            break;
+        case '\\':
+            output += "\\\\";
+            break;
+        case '\n':
+            output += "\\n";
+            break;
+        case '\t':
+            output += "\\t";
+            break;
+        case '\r':
+            output += "\\r";
+            break;
+        default:
+            if((uchar)character < 0x20)
+                output += "\\u00" + QByteArray::number((uchar)character, 16).rightJustified(2, '0');
+            else
+                output += character;
+        }
+    }
+    output += '"';
+}
+
+bool LinboCli::_parseTime(const QCommandLineParser& parser, QString option, QDateTime* time) {
+    if(!parser.isSet(option))
+        return true;
+
+    *time = QDateTime::fromString(parser.value(option), Qt::ISODate);
+    if(!time->isValid()) {
+        this->_err << "Invalid time for --" << option << ": " << parser.value(option) << "\n";
+        this->_err.flush();
+        return false;
+    }
+
+    return true;
+}
+
+QString LinboCli::_logArchiveDirectory(const QCommandLineParser& parser) {
+    if(parser.isSet("archive-dir"))
+        return parser.value("archive-dir");
+    return LinboLogArchive::directoryOf(LinboCacheMount::defaultMountPoint());
+}
@@ -39,6 +39,187 @@ LinboGui::LinboGui()
     this->setFixedWidth(QGuiApplication::screens().at(0)->geometry().width());
 #endif
 
+    // some debug logs
+    qDebug() << "Display width: " << this->width() << " height: " << this->height();
+
+    // create the backend
+    this->_backend = new LinboBackend(this);
+
+    // drives all animations, must be installed before the first one is started
+    this->_animationClock = new LinboAnimationClock(this->_backend->config()->animationFramesPerSecond(), this);
+    this->_animationClock->install();
+    // pauses animations and timers of hidden widgets
+    this->_idleGovernor = new LinboIdleGovernor(this);
+
+    this->_startPage = nullptr;
+    this->_minimalProgressLabel = nullptr;
+
+    // create the theme
+    this->_theme = new LinboGuiTheme(this->_backend, this, this);
+
+    this->_installTranslator();
+
+    if(this->_canUseHeadlessAutostart()) {
+        // nobody can interact before the os starts, the full ui is only built if it is needed after all
+        this->_backend->logger()->_log("Autostart without timeout, skipping the user interface", LinboLogger::LinboGuiInfo);
+        this->_showMinimalProgress();
+        return;
+    }
+
+    this->_buildFullUi();
+}
+
+bool LinboGui::eventFilter(QObject* watched, QEvent* event) {
+    // a key press during the headless autostart brings up the full ui
+    if(event->type() == QEvent::KeyPress && this->_startPage == nullptr)
+        QTimer::singleShot(0, this, &LinboGui::_buildFullUi);
+
+    return QMainWindow::eventFilter(watched, event);
+}
+
+bool LinboGui::_canUseHeadlessAutostart() {
+    return this->_backend->state() == LinboBackend::Autostarting
+           && this->_backend->osOfCurrentAction() != nullptr
+           && this->_backend->osOfCurrentAction()->autostartTimeout() == 0;
+}
+
+void LinboGui::_showMinimalProgress() {
+    // a single label without fonts, icons or animations
+    this->_minimalProgressLabel = new QLabel(this);
+    this->_minimalProgressLabel->setAlignment(Qt::AlignCenter);
+    this->_minimalProgressLabel->setGeometry(0, 0, this->width(), this->height());
+    this->_minimalProgressLabel->setStyleSheet(gTheme->insertValues("QLabel { background: %BackgroundColor; color: %TextColor; }"));
+    //% "Starting"
+    this->_minimalProgressLabel->setText(qtTrId("main_autostart_label") + " " + this->_backend->osOfCurrentAction()->name());
+
+    connect(this->_backend, &LinboBackend::stateChanged, this, &LinboGui::_handleLinboStateChangedInHeadlessAutostart);
+    connect(this->_backend->logger(), &LinboLogger::latestLogChanged, this, &LinboGui::_handleLatestLogChangedInHeadlessAutostart);
+    qApp->installEventFilter(this);
+}
+
+void LinboGui::_handleLinboStateChangedInHeadlessAutostart(LinboBackend::LinboState state) {
+    switch (state) {
+    case LinboBackend::Autostarting:
+    case LinboBackend::Starting:
+    case LinboBackend::Syncing:
+    case LinboBackend::Reinstalling:
+        break;
+    default:
+        // the action failed or did not start the os, now somebody has to look at it
+        this->_buildFullUi();
+        break;
+    }
+}
+
+void LinboGui::_handleLatestLogChangedInHeadlessAutostart(const LinboLogger::LinboLog& latestLog) {
+    if(this->_minimalProgressLabel == nullptr || latestLog.message.isEmpty())
+        return;
+
+    this->_minimalProgressLabel->setText(
+        qtTrId("main_autostart_label") + " " + this->_backend->osOfCurrentAction()->name() + "\n\n" + latestLog.message
+    );
+}
+
+void LinboGui::_buildFullUi() {
+    if(this->_startPage != nullptr)
+        return;
+
+    if(this->_minimalProgressLabel != nullptr) {
+        qApp->removeEventFilter(this);
+        this->_backend->disconnect(this);
+        this->_backend->logger()->disconnect(this);
+        this->_minimalProgressLabel->hide();
+        this->_minimalProgressLabel->deleteLater();
+        this->_minimalProgressLabel = nullptr;
+    }
+
+    this->_loadFonts();
+    this->_openRasterCache();
+
+    // flat background fallback — gradient painted by LinboMainPage::paintEvent()
+    this->setStyleSheet(
+        gTheme->insertValues(
+            "QMainWindow { background: %BackgroundColor; }"
+            "QLabel { color: %TextColor; }"
+            "QToolTip {"
+            "border: 0 0 0 0;"
+            "background: %ElevatedBackgroundColor;"
+            "color: %TextColor;"
+            "padding: %RowPaddingSizepx;"
+            "font-size: %RowFontSizepx;"
+            "}"
+        ));
+
+    // create start page
+    this->_startPage = new LinboMainPage(this->_backend, this);
+    if(this->isVisible())
+        this->_startPage->show();
+
+    // everything visible on the first pages is rasterized by then
+    QTimer::singleShot(5000, this, [=]{
+        this->_closeRasterCache();
+        // its icons are in the pixmap cache now
+        LinboSvgCache::releaseAtlas();
+    });
+}
+
+void LinboGui::_openRasterCache() {
+    // os icons and themes come from the server and are rasterized from svg on every boot,
+    // the results are kept on the cache partition.
+    // Whatever was rendered while it was not mounted is written once something else mounts it
+    connect(this->_backend, &LinboBackend::cacheMounted, this, &LinboGui::_writeRasterCache);
+
+    // linbo-remote might be working on the cache of a disabled client
+    if(!this->_canUseRasterCache())
+        return;
+
+    // mounting would delay the first frame, the cache is only used when it is mounted already
+    this->_rasterCacheMountPoint = LinboCacheMount::acquire(this->_backend->config()->cachePath(), false);
+
+    if(this->_rasterCacheMountPoint.isEmpty())
+        return;
+
+    LinboSvgCache::openDiskCache(this->_rasterCacheMountPoint + "/linbo-gui-rastercache");
+}
+
+void LinboGui::_closeRasterCache() {
+    if(this->_rasterCacheMountPoint.isEmpty())
+        return;
+
+    // nothing is written while linbo_cmd works on the cache
+    LinboSvgCache::closeDiskCache(this->_canUseRasterCache());
+    LinboCacheMount::release(this->_backend->config()->cachePath());
+
+    this->_rasterCacheMountPoint.clear();
+}
+
+void LinboGui::_writeRasterCache() {
+    if(!this->_rasterCacheMountPoint.isEmpty() || !LinboSvgCache::hasPendingDiskCacheWrites() || !this->_canUseRasterCache())
+        return;
+
+    // whoever mounted the cache still holds it, this must not mount it again
+    QString mountPoint = LinboCacheMount::acquire(this->_backend->config()->cachePath(), false);
+    if(mountPoint.isEmpty())
+        return;
+
+    LinboSvgCache::openDiskCache(mountPoint + "/linbo-gui-rastercache");
+    LinboSvgCache::closeDiskCache();
+    LinboCacheMount::release(this->_backend->config()->cachePath());
+}
+
+bool LinboGui::_canUseRasterCache() {
+    switch (this->_backend->state()) {
+    case LinboBackend::Idle:
+    case LinboBackend::Autostarting:
+    case LinboBackend::Root:
+    case LinboBackend::RootTimeout:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void LinboGui::_loadFonts() {
     // Load Lato font (primary)
     int latoOk = QFontDatabase::addApplicationFont(":/fonts/Lato-Regular.ttf");
     QFontDatabase::addApplicationFont(":/fonts/Lato-Bold.ttf");
@@ -71,30 +252,9 @@ LinboGui::LinboGui()
     QFont resolvedFont = QApplication::font();
     qDebug() << "Default font set to:" << resolvedFont.family() << "| actually resolved:"
              << QFontInfo(resolvedFont).family();
+}
 
-    // some debug logs
-    qDebug() << "Display width: " << this->width() << " height: " << this->height();
-
-    // create the backend
-    this->_backend = new LinboBackend(this);
-
-    // create the theme
-    this->_theme = new LinboGuiTheme(this->_backend, this, this);
-
-    // flat background fallback — gradient painted by LinboMainPage::paintEvent()
-    this->setStyleSheet(
-        gTheme->insertValues(
-            "QMainWindow { background: %BackgroundColor; }"
-            "QLabel { color: %TextColor; }"
-            "QToolTip {"
-            "border: 0 0 0 0;"
-            "background: %ElevatedBackgroundColor;"
-            "color: %TextColor;"
-            "padding: %RowPaddingSizepx;"
-            "font-size: %RowFontSizepx;"
-            "}"
-        ));
-
+void LinboGui::_installTranslator() {
     // attach translator
     QString localeName = this->_backend->config()->locale();
     if(localeName.isEmpty() || (localeName.length() == 5 && localeName[2] == '-')) {
@@ -115,8 +275,4 @@ LinboGui::LinboGui()
 
         QApplication::installTranslator(translator);
     }
-
-    // create start page
-    this->_startPage = new LinboMainPage(this->_backend, this);
-
 }
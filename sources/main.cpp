@@ -19,9 +19,16 @@
 #include <QApplication>
 
 #include "linbogui.h"
+#include "linbocli.h"
 
 int main( int argc, char* argv[] )
 {
+  if(LinboCli::isCliInvocation(argc, argv)) {
+    QCoreApplication linboCliApp( argc, argv );
+    LinboCli linboCli;
+    return linboCli.exec(linboCliApp.arguments());
+  }
+
   QApplication linboGuiApp( argc, argv );
 
   QApplication::setStyle("fusion");
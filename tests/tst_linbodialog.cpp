@@ -0,0 +1,100 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+/*
+ * Checks that a dialog does not connect to its close button again whenever its
+ * tab order is rebuilt, see LinboDialog::_updateTabOrder()
+ */
+
+#include <QtTest>
+#include <QMainWindow>
+
+#include "linbobackend.h"
+#include "linboguitheme.h"
+#include "linbodialog.h"
+#include "linbotoolbutton.h"
+
+class TestLinboDialog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void closeButtonIsConnectedOnce();
+
+private:
+    QMainWindow* _mainWindow;
+    LinboBackend* _backend;
+
+    int _defocusedReceivers(LinboToolButton* closeButton);
+};
+
+void TestLinboDialog::initTestCase() {
+    this->_mainWindow = new QMainWindow();
+    this->_mainWindow->resize(1024, 768);
+    this->_backend = new LinboBackend(nullptr, false);
+    new LinboGuiTheme(this->_backend, this->_mainWindow, this->_mainWindow);
+}
+
+void TestLinboDialog::cleanupTestCase() {
+    delete this->_mainWindow;
+    delete this->_backend;
+}
+
+void TestLinboDialog::closeButtonIsConnectedOnce() {
+    QWidget* parent = new QWidget(this->_mainWindow);
+    this->_mainWindow->setCentralWidget(parent);
+    this->_mainWindow->show();
+    QVERIFY(QTest::qWaitForWindowExposed(this->_mainWindow));
+
+    LinboDialog* dialog = new LinboDialog(parent);
+    dialog->setGeometry(0, 0, 400, 300);
+    dialog->show();
+
+    // the dialog's toolbar lives on its parent and only holds the close button
+    LinboToolButton* closeButton = parent->findChild<LinboToolButton*>();
+    QVERIFY(closeButton != nullptr);
+    QCOMPARE(this->_defocusedReceivers(closeButton), 1);
+
+    for(int i = 0; i < 50; i++) {
+        dialog->repaint();
+        QCOMPARE(this->_defocusedReceivers(closeButton), 1);
+    }
+
+    // changing the children outdates the tab order, so the next paint rebuilds it
+    for(int i = 0; i < 10; i++) {
+        QWidget* child = new QWidget(dialog);
+        child->setFocusPolicy(Qt::StrongFocus);
+        child->show();
+        dialog->repaint();
+        child->hide();
+        dialog->repaint();
+        delete child;
+        dialog->repaint();
+        QCOMPARE(this->_defocusedReceivers(closeButton), 1);
+    }
+}
+
+int TestLinboDialog::_defocusedReceivers(LinboToolButton* closeButton) {
+    // receivers() is protected, LinboToolButton is a friend of the test
+    return closeButton->receivers(SIGNAL(defocused(Qt::FocusReason)));
+}
+
+QTEST_MAIN(TestLinboDialog)
+#include "tst_linbodialog.moc"
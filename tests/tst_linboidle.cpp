@@ -0,0 +1,103 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+/*
+ * Checks that the main page neither paints nor wakes up the event loop while LINBO is idle,
+ * see LinboActivityMonitor, LinboAnimationClock and LinboIdleGovernor
+ */
+
+#include <QtTest>
+#include <QMainWindow>
+#include <QEventLoop>
+
+#include "linbobackend.h"
+#include "linboactivitymonitor.h"
+#include "linboanimationclock.h"
+#include "linboidlegovernor.h"
+#include "linboguitheme.h"
+#include "linbomainpage.h"
+
+class TestLinboIdle : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void mainPageIsQuietWhenIdle();
+
+private:
+    // generous, an idle screen should be close to zero. The freshness checker and the clock of the
+    // client info may still wake up now and then
+    static const int _maxPaintEventsPerSecond = 2;
+    static const int _maxWakeupsPerSecond = 10;
+
+    QMainWindow* _mainWindow;
+    LinboBackend* _backend;
+
+    void _runEventLoop(int milliseconds);
+};
+
+void TestLinboIdle::initTestCase() {
+    // the same setup as LinboGui, without the automatic tasks (the fake start.conf would autostart)
+    this->_mainWindow = new QMainWindow();
+    this->_mainWindow->resize(1024, 768);
+    this->_backend = new LinboBackend(nullptr, false);
+    LinboAnimationClock* animationClock = new LinboAnimationClock(this->_backend->config()->animationFramesPerSecond(), this->_mainWindow);
+    animationClock->install();
+    new LinboIdleGovernor(this->_mainWindow);
+    new LinboGuiTheme(this->_backend, this->_mainWindow, this->_mainWindow);
+}
+
+void TestLinboIdle::cleanupTestCase() {
+    delete this->_mainWindow;
+    delete this->_backend;
+}
+
+void TestLinboIdle::mainPageIsQuietWhenIdle() {
+    QCOMPARE(this->_backend->state(), LinboBackend::Idle);
+
+    new LinboMainPage(this->_backend, this->_mainWindow);
+    this->_mainWindow->show();
+    QVERIFY(QTest::qWaitForWindowExposed(this->_mainWindow));
+
+    // the first frames and the animations of showing the page
+    this->_runEventLoop(3000);
+
+    LinboActivityMonitor activityMonitor;
+    LinboActivityMonitor::Sample from = activityMonitor.sample();
+    this->_runEventLoop(1000);
+    LinboActivityMonitor::Sample to = activityMonitor.sample();
+
+    double paintEventsPerSecond = LinboActivityMonitor::paintEventsPerSecond(from, to);
+    double wakeupsPerSecond = LinboActivityMonitor::wakeupsPerSecond(from, to);
+    qInfo() << "Idle:" << paintEventsPerSecond << "paint events and" << wakeupsPerSecond << "wakeups per second";
+
+    QVERIFY2(paintEventsPerSecond <= _maxPaintEventsPerSecond, qPrintable(QString::number(paintEventsPerSecond) + " paint events per second"));
+    QVERIFY2(wakeupsPerSecond <= _maxWakeupsPerSecond, qPrintable(QString::number(wakeupsPerSecond) + " wakeups per second"));
+}
+
+void TestLinboIdle::_runEventLoop(int milliseconds) {
+    // unlike QTest::qWait(), this sleeps until something happens, so it does not add wakeups itself
+    QEventLoop eventLoop;
+    QTimer::singleShot(milliseconds, &eventLoop, &QEventLoop::quit);
+    eventLoop.exec();
+}
+
+QTEST_MAIN(TestLinboIdle)
+#include "tst_linboidle.moc"
@@ -0,0 +1,106 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+/*
+ * Runs a job queue against the fake linbo_cmd of the fake root, see LinboJobQueue
+ */
+
+#include <QtTest>
+
+#include "linbobackend.h"
+#include "linbojob.h"
+#include "linbojobqueue.h"
+
+class TestLinboJobQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void createsAndUploadsImage_data();
+    void createsAndUploadsImage();
+
+private:
+    LinboBackend* _backend;
+
+    LinboOs* _findOs(QString name);
+};
+
+void TestLinboJobQueue::initTestCase() {
+    this->_backend = new LinboBackend(nullptr, false);
+    // the password the fake linbo_cmd accepts
+    QVERIFY(this->_backend->login("Muster!"));
+    QCOMPARE(this->_backend->state(), LinboBackend::Root);
+}
+
+void TestLinboJobQueue::cleanupTestCase() {
+    delete this->_backend;
+}
+
+void TestLinboJobQueue::createsAndUploadsImage_data() {
+    QTest::addColumn<bool>("pipelined");
+    QTest::newRow("serial") << false;
+    // both use the cache, so the upload still waits
+    QTest::newRow("pipelined") << true;
+}
+
+void TestLinboJobQueue::createsAndUploadsImage() {
+    QFETCH(bool, pipelined);
+    LinboOs* os = this->_findOs("Ubuntu");
+    QVERIFY(os != nullptr && os->baseImage() != nullptr);
+
+    LinboJobQueue* jobQueue = this->_backend->jobQueue();
+    QVERIFY(jobQueue->clear());
+    QVERIFY(jobQueue->setPipelined(pipelined));
+    LinboJob* createJob = new LinboJob(LinboJob::CreateBaseImageJob, os);
+    LinboJob* uploadJob = new LinboJob(LinboJob::UploadImageJob, os);
+    QVERIFY(jobQueue->append(createJob));
+    QVERIFY(jobQueue->append(uploadJob));
+
+    QSignalSpy finishedSpy(jobQueue, &LinboJobQueue::finished);
+    QVERIFY(jobQueue->start());
+
+    // the upload needs the image of the create job
+    QCOMPARE(createJob->status(), LinboJob::Running);
+    QCOMPARE(uploadJob->status(), LinboJob::Pending);
+    QCOMPARE(this->_backend->state(), LinboBackend::CreatingImage);
+
+    // the fake linbo_cmd takes about 25 seconds for both
+    QVERIFY(finishedSpy.wait(120000));
+    QCOMPARE(finishedSpy.first().first().toBool(), true);
+
+    QCOMPARE(createJob->status(), LinboJob::Succeeded);
+    QCOMPARE(uploadJob->status(), LinboJob::Succeeded);
+    QVERIFY(createJob->finishedAt() <= uploadJob->startedAt());
+    QCOMPARE(this->_backend->state(), LinboBackend::RootActionSuccess);
+    QVERIFY(!jobQueue->isRunning());
+    QVERIFY(jobQueue->backgroundJob() == nullptr);
+
+    QVERIFY(this->_backend->resetMessage());
+}
+
+LinboOs* TestLinboJobQueue::_findOs(QString name) {
+    for(LinboOs* os : this->_backend->config()->operatingSystems())
+        if(os->name() == name)
+            return os;
+    return nullptr;
+}
+
+QTEST_GUILESS_MAIN(TestLinboJobQueue)
+#include "tst_linbojobqueue.moc"
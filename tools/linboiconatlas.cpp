@@ -0,0 +1,111 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+/*
+ * Build tool: rasterizes the bundled svg icons at a set of sizes into one image per size
+ * (atlas-<size>.png, the icon atlas) and writes an index with the position of each icon in the image of its size, eg.
+ *
+ *   :/icons/dark/back.svg 32 0 0
+ *
+ * Usage: linbo_icon_atlas <output dir> <sizes, eg. 32,48> <resources dir> <icon files relative to the source dir...>
+ *
+ * All files are embedded under :/iconatlas/ and used by LinboSvgCache, which only decodes the images of the sizes it needs.
+ */
+
+#include <QGuiApplication>
+#include <QSvgRenderer>
+#include <QPainter>
+#include <QImage>
+#include <QFile>
+#include <QDir>
+#include <QTextStream>
+#include <QList>
+#include <algorithm>
+
+static const int atlasWidth = 1024;
+
+int main(int argc, char *argv[])
+{
+    QGuiApplication app(argc, argv);
+
+    QStringList arguments = app.arguments();
+    if(arguments.length() < 5) {
+        QTextStream(stderr) << "Usage: linbo_icon_atlas <output dir> <sizes> <resources dir> <icons...>\n";
+        return 1;
+    }
+
+    QDir outputDir(arguments.at(1));
+    QDir resourcesDir(arguments.at(3));
+
+    QList<int> sizes;
+    for(const QString& size : arguments.at(2).split(",", Qt::SkipEmptyParts))
+        if(size.toInt() > 0)
+            sizes.append(size.toInt());
+    std::sort(sizes.begin(), sizes.end());
+
+    QStringList icons = arguments.mid(4);
+
+    QFile indexFile(outputDir.filePath("atlas.index"));
+    if(!indexFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        QTextStream(stderr) << "Could not write " << indexFile.fileName() << "\n";
+        return 1;
+    }
+    QTextStream index(&indexFile);
+
+    for(int size : sizes) {
+        // simple shelf packing, every shelf has the height of the size
+        int iconsPerShelf = qMax(1, atlasWidth / size);
+        int height = ((icons.length() + iconsPerShelf - 1) / iconsPerShelf) * size;
+
+        QImage atlas(atlasWidth, qMax(1, height), QImage::Format_ARGB32_Premultiplied);
+        atlas.fill(Qt::transparent);
+
+        QPainter painter(&atlas);
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        int x = 0;
+        int y = 0;
+        for(const QString& icon : icons) {
+            // the path relative to the source dir, eg. resources/icons/dark/back.svg -> :/icons/dark/back.svg
+            QString relativePath = icon.section("/", 1);
+            QSvgRenderer renderer(resourcesDir.filePath(relativePath));
+            if(!renderer.isValid()) {
+                QTextStream(stderr) << "Skipping invalid icon " << icon << "\n";
+                continue;
+            }
+
+            if(x + size > atlasWidth) {
+                x = 0;
+                y += size;
+            }
+
+            renderer.render(&painter, QRectF(x, y, size, size));
+            index << ":/" << relativePath << " " << size << " " << x << " " << y << "\n";
+            x += size;
+        }
+        painter.end();
+
+        QString atlasFileName = "atlas-" + QString::number(size) + ".png";
+        if(!atlas.save(outputDir.filePath(atlasFileName))) {
+            QTextStream(stderr) << "Could not write " << outputDir.filePath(atlasFileName) << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/****************************************************************************
+ ** Modern Linbo GUI
+ ** Copyright (C) 2020-2021  Dorian Zedler <dorian@itsblue.de>
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU Affero General Public License as published
+ ** by the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU Affero General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Affero General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+/*
+ * Benchmark tool: measures the time per frame to paint the main page into the backing store of
+ * its window and to flush it, once with LinboRenderConfig turned off (layers in the format they
+ * were created in, main page not opaque) and once with it turned on.
+ *
+ * Usage: linbo_render_benchmark [<frames> [<width> <height>]]
+ *
+ * Without a size, the window covers the screen like the gui does. The format of the backing store
+ * is chosen by the platform plugin, so run it with QT_QPA_PLATFORM=linuxfb on the target to
+ * measure the flush to the framebuffer.
+ */
+
+#include <QApplication>
+#include <QBackingStore>
+#include <QElapsedTimer>
+#include <QFontDatabase>
+#include <QImage>
+#include <QMainWindow>
+#include <QScreen>
+#include <QTextStream>
+#include <QWindow>
+
+#include "linbobackend.h"
+#include "linboguitheme.h"
+#include "linbomainpage.h"
+#include "linborenderconfig.h"
+#include "linbosvgcache.h"
+
+struct Measurement {
+    double milliseconds;
+    QImage::Format backingStoreFormat;
+};
+
+static void paintFrame(QMainWindow* window) {
+    QBackingStore* backingStore = window->backingStore();
+    QRegion region(window->rect());
+
+    backingStore->beginPaint(region);
+    window->render(backingStore->paintDevice(), QPoint(), region);
+    backingStore->endPaint();
+    backingStore->flush(region, window->windowHandle());
+}
+
+static Measurement measure(LinboBackend* backend, QSize size, int frames, bool renderConfig) {
+    // everything cached was created with the other setting
+    LinboRenderConfig::setEnabled(renderConfig);
+    LinboSvgCache::clear();
+
+    QMainWindow* window = new QMainWindow();
+    window->setWindowFlags(Qt::FramelessWindowHint);
+    window->setFixedSize(size);
+
+    // the widgets use the theme until they are deleted
+    LinboGuiTheme* theme = new LinboGuiTheme(backend, window);
+    window->setStyleSheet(theme->insertValues("QMainWindow { background: %BackgroundColor; } QLabel { color: %TextColor; }"));
+
+    new LinboMainPage(backend, window);
+    window->show();
+
+    // let the window be exposed and the background layer and icons be rasterized before timing
+    while(!window->windowHandle()->isExposed())
+        QApplication::processEvents(QEventLoop::WaitForMoreEvents, 100);
+    QApplication::processEvents();
+    paintFrame(window);
+
+    Measurement result;
+    QImage* backingStoreImage = dynamic_cast<QImage*>(window->backingStore()->paintDevice());
+    result.backingStoreFormat = backingStoreImage == nullptr ? QImage::Format_Invalid : backingStoreImage->format();
+
+    QElapsedTimer timer;
+    timer.start();
+    for(int frame = 0; frame < frames; frame++)
+        paintFrame(window);
+    result.milliseconds = double(timer.nsecsElapsed()) / 1000000 / frames;
+
+    delete window;
+    delete theme;
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QApplication::setStyle("fusion");
+
+    QStringList arguments = app.arguments();
+    int frames = arguments.length() >= 2 ? arguments.at(1).toInt() : 200;
+    QSize size = QGuiApplication::primaryScreen()->geometry().size();
+    if(arguments.length() >= 4)
+        size = QSize(arguments.at(2).toInt(), arguments.at(3).toInt());
+
+    if(frames < 1 || size.isEmpty()) {
+        QTextStream(stderr) << "Usage: linbo_render_benchmark [<frames> [<width> <height>]]\n";
+        return 1;
+    }
+
+    QFontDatabase::addApplicationFont(":/fonts/Lato-Regular.ttf");
+    QFontDatabase::addApplicationFont(":/fonts/Lato-Bold.ttf");
+    QFont defaultFont("Lato");
+    defaultFont.setStyleStrategy(QFont::PreferAntialias);
+    QApplication::setFont(defaultFont);
+
+    // no automatic tasks, nothing is started or synced while measuring
+    LinboBackend backend(nullptr, false);
+
+    Measurement before = measure(&backend, size, frames, false);
+    Measurement after = measure(&backend, size, frames, true);
+
+    QTextStream out(stdout);
+    out << size.width() << "x" << size.height() << ", " << LinboRenderConfig::framebufferDepth() << " bit screen, "
+        << frames << " frames, backing store format " << int(after.backingStoreFormat) << "\n";
+    out << "LinboRenderConfig off: " << QString::number(before.milliseconds, 'f', 3) << " ms per frame\n";
+    out << "LinboRenderConfig on:  " << QString::number(after.milliseconds, 'f', 3) << " ms per frame\n";
+    return 0;
+}